@@ -18,17 +18,35 @@ typedef struct Config_ {
         gboolean post_update_reboot;      /**< reboot system after successful update */
         gboolean resume_downloads;        /**< resume downloads or not */
         gboolean stream_bundle;           /**< streaming installation or not */
+        gboolean prefer_delta;            /**< prefer casync-based delta artifacts */
         gchar* auth_token;                /**< hawkBit target security token */
         gchar* gateway_token;             /**< hawkBit gateway security token */
         gchar* tenant_id;                 /**< hawkBit tenant id */
         gchar* controller_id;             /**< hawkBit controller id*/
         gchar* bundle_download_location;  /**< file to download rauc bundle to */
+        gchar* bundle_cache_dir;          /**< directory for the content-addressed bundle cache */
+        gint64 bundle_cache_size;         /**< bundle cache disk budget in bytes, 0 = unlimited */
+        gchar* metrics_file;              /**< file to export runtime metrics to */
+        gchar* http_version;              /**< HTTP version: auto, 1.1, 2, 2-prior-knowledge */
+        gboolean ssl_session_cache;       /**< reuse TLS sessions across connections */
+        gboolean compress_responses;      /**< negotiate compressed REST responses */
+        gboolean compress_requests;       /**< gzip large REST request bodies */
+        gboolean tcp_fast_open;           /**< use TCP fast open for connects */
         int connect_timeout;              /**< connection timeout */
         int timeout;                      /**< reply timeout */
         int retry_wait;                   /**< wait between retries */
+        int progress_interval;            /**< min. seconds between progress feedback flushes */
+        int identify_interval;            /**< seconds after which unchanged configData is re-uploaded, 0 = only on change */
+        int download_connections;         /**< number of parallel connections for bundle downloads */
+        int download_buffer_size;         /**< curl receive buffer size for bundle downloads */
         int low_speed_time;               /**< time to be below the speed to trigger low speed abort */
         int low_speed_rate;               /**< low speed limit to abort transfer */
+        int max_download_rate;            /**< download rate ceiling in bytes/s, 0 = unlimited */
+        int rate_limit_window_start;      /**< minute of day the rate limit window starts, -1 = always */
+        int rate_limit_window_end;        /**< minute of day the rate limit window ends */
+        int download_start_jitter;        /**< max. random delay in seconds before starting a download */
         GLogLevelFlags log_level;         /**< log level */
+        gboolean log_async;               /**< write log output via async writer thread */
         GHashTable* device;               /**< Additional attributes sent to hawkBit */
 } Config;
 
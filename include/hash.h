@@ -0,0 +1,58 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * SPDX-FileCopyrightText: 2022 Prevas A/S (www.prevas.com)
+ */
+
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include <glib.h>
+
+/**
+ * @brief Supported hash types.
+ */
+typedef enum {
+        HASH_TYPE_SHA1,
+        HASH_TYPE_SHA256,
+} HashType;
+
+typedef struct Hash_ Hash;
+
+/**
+ * @brief Create a streaming hash context. The backend is selected at build
+ *        time: OpenSSL EVP (SIMD/SHA instruction accelerated) if built with
+ *        -Dopenssl=enabled, GLib's GChecksum otherwise.
+ *
+ * @param[in] type Hash type
+ * @return newly allocated Hash, to be freed with hash_free()
+ */
+Hash* hash_new(HashType type);
+
+/**
+ * @brief Feed data into the hash context.
+ *
+ * @param[in] hash   Hash context
+ * @param[in] data   Data to hash
+ * @param[in] length Length of data in bytes
+ */
+void hash_update(Hash *hash, const guchar *data, gsize length);
+
+/**
+ * @brief Get the final digest as hex string. Finalizes the context, no
+ *        further hash_update() calls are allowed afterwards.
+ *
+ * @param[in] hash Hash context
+ * @return digest hex string, owned by the Hash
+ */
+const gchar* hash_get_string(Hash *hash);
+
+/**
+ * @brief Frees the memory allocated by a Hash
+ *
+ * @param[in] hash Hash to free
+ */
+void hash_free(Hash *hash);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(Hash, hash_free)
+
+#endif // __HASH_H__
@@ -9,8 +9,11 @@
 #include <glib.h>
 #include <glib/gtypes.h>
 #include <stdio.h>
+#include <curl/curl.h>
+#include <json-glib/json-glib.h>
 
 #include "config-file.h"
+#include "hash.h"
 
 #define RHU_HAWKBIT_CLIENT_ERROR rhu_hawkbit_client_error_quark()
 GQuark rhu_hawkbit_client_error_quark(void);
@@ -23,6 +26,7 @@ typedef enum {
         RHU_HAWKBIT_CLIENT_ERROR_DOWNLOAD,
         RHU_HAWKBIT_CLIENT_ERROR_STREAM_INSTALL,
         RHU_HAWKBIT_CLIENT_ERROR_CANCELATION,
+        RHU_HAWKBIT_CLIENT_ERROR_INSTALL,
 } RHUHawkbitClientError;
 
 // uses CURLcode as error codes
@@ -35,7 +39,6 @@ GQuark rhu_hawkbit_client_http_error_quark(void);
 
 #define HAWKBIT_USERAGENT                 "rauc-hawkbit-c-agent/1.0"
 #define DEFAULT_CURL_REQUEST_BUFFER_SIZE  512
-#define DEFAULT_CURL_DOWNLOAD_BUFFER_SIZE 64 * 1024 // 64KB
 
 extern gboolean run_once;                  /**< only run software check once and exit */
 
@@ -78,6 +81,7 @@ struct HawkbitAction {
 typedef struct RestPayload_ {
         gchar *payload;               /**< string representation of payload */
         size_t size;                  /**< size of payload */
+        size_t capacity;              /**< allocated size of payload buffer */
 } RestPayload;
 
 /**
@@ -90,6 +94,7 @@ typedef struct Artifact_ {
         gchar *download_url;          /**< download URL of software bundle file */
         gchar *feedback_url;          /**< URL status feedback should be sent to */
         gchar *sha1;                  /**< sha1 checksum of software bundle file */
+        gchar *sha256;                /**< sha256 checksum of software bundle file or NULL */
         gchar *maintenance_window;    /**< maintenance flag, possible values: available, unavailable, null */
         gboolean do_install;          /**< whether the installation should be started or not */
 } Artifact;
@@ -147,6 +152,38 @@ gboolean hawkbit_progress(const gchar *msg);
  */
 gboolean install_complete_cb(gpointer ptr);
 
+/**
+ * @brief Curl callback writing REST response to RestPayload*->payload buffer.
+ *        The buffer grows geometrically instead of once per received chunk.
+ *        Non-static so the benchmark suite can exercise the production
+ *        buffer-growth path.
+ *
+ * @see   https://curl.haxx.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
+ */
+size_t curl_write_cb(const void *content, size_t size, size_t nmemb, void *data);
+
+/**
+ * @brief Perform REST request with JSON data, expecting response JSON data.
+ *        Non-static so the benchmark suite can measure the production
+ *        request engine; see the implementation for parameter details.
+ *
+ * @return TRUE if request and response parser (if given) suceeded, FALSE otherwise (error set)
+ */
+gboolean rest_request(enum HTTPMethod method, const gchar *url, JsonBuilder *jsonRequestBody,
+                      JsonParser **jsonResponseParser, glong *retry_after_sec,
+                      gboolean *unmodified, GError **error);
+
+/**
+ * @brief Download download_url to file.
+ *        Non-static so the benchmark suite can measure the production
+ *        download engine; see the implementation for parameter details.
+ *
+ * @return TRUE if download succeeded, FALSE otherwise (error set)
+ */
+gboolean get_binary(const gchar *download_url, const gchar *file, curl_off_t resume_from,
+                    curl_off_t file_size, HashType hash_type, gchar **checksum_out,
+                    curl_off_t *speed, GError **error);
+
 /**
  * @brief Frees the memory allocated by a RestPayload
  *
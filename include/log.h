@@ -17,7 +17,11 @@
  * @param[in] domain Log domain
  * @param[in] level  Log level
  * @param[in] p_output_to_systemd output to systemd journal
+ * @param[in] async  queue messages in a ring buffer drained by a writer
+ *                   thread instead of writing synchronously (fatal messages
+ *                   are always written in line)
  */
-void setup_logging(const gchar *domain, GLogLevelFlags level, gboolean output_to_systemd);
+void setup_logging(const gchar *domain, GLogLevelFlags level, gboolean output_to_systemd,
+                   gboolean async);
 
 #endif // __LOG_H__
@@ -0,0 +1,43 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * SPDX-FileCopyrightText: 2022 Prevas A/S (www.prevas.com)
+ */
+
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include <glib.h>
+#include <curl/curl.h>
+
+/**
+ * @brief Enable metrics collection, exported to path on metrics_write().
+ *        If path is NULL, metrics collection stays disabled and all other
+ *        metrics functions are no-ops.
+ *
+ * @param[in] path Textfile to export metrics to or NULL
+ */
+void metrics_init(const gchar *path);
+
+/**
+ * @brief Record timing breakdown (DNS lookup, connect, time to first byte,
+ *        total) of a completed Curl transfer.
+ *
+ * @param[in] curl     Curl handle the transfer was performed on
+ * @param[in] download TRUE for bundle downloads, FALSE for REST requests
+ */
+void metrics_record_transfer(CURL *curl, gboolean download);
+
+/**
+ * @brief Count a completed base resource poll.
+ *
+ * @param[in] success Whether the poll succeeded
+ */
+void metrics_record_poll(gboolean success);
+
+/**
+ * @brief Export current metrics in Prometheus text format to the configured
+ *        textfile (written atomically), for node-exporter style collection.
+ */
+void metrics_write(void);
+
+#endif // __METRICS_H__
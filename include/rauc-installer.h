@@ -19,10 +19,14 @@ struct install_context {
         GSourceFunc notify_complete;  /**< Callback function */
         GMutex status_mutex;          /**< Mutex used for accessing status_messages */
         GQueue status_messages;       /**< Queue of status messages from Rauc DBUS */
+        gboolean notify_pending;      /**< Whether a notify_event dispatch is already scheduled,
+                                           so queued messages are drained in one callback */
         gint status_result;           /**< The result of the installation */
         GMainLoop *mainloop;          /**< The installation GMainLoop  */
         GMainContext *loop_context;   /**< GMainContext for the GMainLoop */
         gboolean keep_install_context; /**< Whether the installation thread should free this struct or keep it */
+        GCond done_cond;              /**< Condition on done */
+        gboolean done;                /**< Whether the installation finished (status_result valid) */
 };
 
 /**
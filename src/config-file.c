@@ -9,16 +9,19 @@
 
 #include "config-file.h"
 #include <glib/gtypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 
-static const gint DEFAULT_CONNECTTIMEOUT  = 20;     // 20 sec.
-static const gint DEFAULT_TIMEOUT         = 60;     // 1 min.
-static const gint DEFAULT_RETRY_WAIT      = 5 * 60; // 5 min.
-static const gboolean DEFAULT_SSL         = TRUE;
-static const gboolean DEFAULT_SSL_VERIFY  = TRUE;
-static const gboolean DEFAULT_REBOOT      = FALSE;
-static const gchar* DEFAULT_LOG_LEVEL     = "message";
+static const gint DEFAULT_CONNECTTIMEOUT    = 20;         // 20 sec.
+static const gint DEFAULT_TIMEOUT           = 60;         // 1 min.
+static const gint DEFAULT_RETRY_WAIT        = 5 * 60;     // 5 min.
+static const gint DEFAULT_PROGRESS_INTERVAL = 2;          // 2 sec.
+static const gint DEFAULT_DOWNLOAD_BUFFER   = 64 * 1024;  // 64 KiB
+static const gboolean DEFAULT_SSL           = TRUE;
+static const gboolean DEFAULT_SSL_VERIFY    = TRUE;
+static const gboolean DEFAULT_REBOOT        = FALSE;
+static const gchar* DEFAULT_LOG_LEVEL       = "message";
 
 /**
  * @brief Get string value from key_file for key in group, optional default_value can be specified
@@ -151,6 +154,46 @@ static gboolean get_key_int(GKeyFile *key_file, const gchar *group, const gchar
         return TRUE;
 }
 
+/**
+ * @brief Get 64 bit integer value from key_file for key in group, default_value must be
+ * specified, returned in case key not found in group.
+ *
+ * @param[in]  key_file      GKeyFile to look value up
+ * @param[in]  group         A group name
+ * @param[in]  key           A key
+ * @param[out] value         Output integer value
+ * @param[in]  default_value Return this value in case no value found
+ * @param[out] error         Error
+ * @return FALSE on error (error is set), TRUE otherwise. Note that TRUE is returned if key in
+ *         group is not found, value is set to default_value in this case.
+ */
+static gboolean get_key_int64(GKeyFile *key_file, const gchar *group, const gchar *key,
+                              gint64 *value, const gint64 default_value, GError **error)
+{
+        GError *ierror = NULL;
+        gint64 val;
+
+        g_return_val_if_fail(key_file, FALSE);
+        g_return_val_if_fail(group, FALSE);
+        g_return_val_if_fail(key, FALSE);
+        g_return_val_if_fail(value, FALSE);
+        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+        val = g_key_file_get_int64(key_file, group, key, &ierror);
+
+        if (g_error_matches(ierror, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_KEY_NOT_FOUND)) {
+                g_clear_error(&ierror);
+                *value = default_value;
+                return TRUE;
+        } else if (ierror) {
+                g_propagate_error(error, ierror);
+                return FALSE;
+        }
+
+        *value = val;
+        return TRUE;
+}
+
 /**
  * @brief Get GHashTable containing keys/values from group in key_file.
  *
@@ -236,7 +279,7 @@ static GLogLevelFlags log_level_from_string(const gchar *log_level)
 Config* load_config_file(const gchar *config_file, GError **error)
 {
         g_autoptr(Config) config = NULL;
-        g_autofree gchar *val = NULL;
+        g_autofree gchar *val = NULL, *rate_window = NULL;
         g_autoptr(GKeyFile) ini_file = NULL;
         gboolean key_auth_token_exists = FALSE;
         gboolean key_gateway_token_exists = FALSE;
@@ -277,6 +320,12 @@ Config* load_config_file(const gchar *config_file, GError **error)
                 return NULL;
         bundle_location_given = get_key_string(ini_file, "client", "bundle_download_location",
                                                &config->bundle_download_location, NULL, NULL);
+        get_key_string(ini_file, "client", "metrics_file", &config->metrics_file, NULL, NULL);
+        get_key_string(ini_file, "client", "bundle_cache_dir", &config->bundle_cache_dir, NULL,
+                       NULL);
+        if (!get_key_int64(ini_file, "client", "bundle_cache_size", &config->bundle_cache_size,
+                           0, error))
+                return NULL;
         if (!get_key_bool(ini_file, "client", "ssl", &config->ssl, DEFAULT_SSL, error))
                 return NULL;
         if (!get_key_bool(ini_file, "client", "ssl_verify", &config->ssl_verify,
@@ -292,6 +341,12 @@ Config* load_config_file(const gchar *config_file, GError **error)
         if (!get_key_int(ini_file, "client", "retry_wait", &config->retry_wait, DEFAULT_RETRY_WAIT,
                          error))
                 return NULL;
+        if (!get_key_int(ini_file, "client", "progress_interval", &config->progress_interval,
+                         DEFAULT_PROGRESS_INTERVAL, error))
+                return NULL;
+        if (!get_key_int(ini_file, "client", "identify_interval", &config->identify_interval, 0,
+                         error))
+                return NULL;
         if (!get_key_int(ini_file, "client", "low_speed_rate", &config->low_speed_rate, 100,
                          error))
                 return NULL;
@@ -300,16 +355,90 @@ Config* load_config_file(const gchar *config_file, GError **error)
         if (!get_key_bool(ini_file, "client", "resume_downloads", &config->resume_downloads, FALSE,
                           error))
                 return NULL;
+        if (!get_key_int(ini_file, "client", "download_connections",
+                         &config->download_connections, 1, error))
+                return NULL;
+        if (!get_key_int(ini_file, "client", "max_download_rate", &config->max_download_rate, 0,
+                         error))
+                return NULL;
+        if (!get_key_int(ini_file, "client", "download_buffer_size",
+                         &config->download_buffer_size, DEFAULT_DOWNLOAD_BUFFER, error))
+                return NULL;
+        if (!get_key_int(ini_file, "client", "download_start_jitter",
+                         &config->download_start_jitter, 0, error))
+                return NULL;
+        config->rate_limit_window_start = -1;
+        config->rate_limit_window_end = -1;
+        if (get_key_string(ini_file, "client", "rate_limit_window", &rate_window, NULL, NULL)) {
+                int start_hour, start_min, end_hour, end_min;
+
+                if (sscanf(rate_window, "%2d:%2d-%2d:%2d", &start_hour, &start_min, &end_hour,
+                           &end_min) != 4 ||
+                    start_hour < 0 || start_hour > 23 || start_min < 0 || start_min > 59 ||
+                    end_hour < 0 || end_hour > 23 || end_min < 0 || end_min > 59) {
+                        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                                    "Invalid 'rate_limit_window': %s (expected HH:MM-HH:MM)",
+                                    rate_window);
+                        return NULL;
+                }
+
+                config->rate_limit_window_start = start_hour * 60 + start_min;
+                config->rate_limit_window_end = end_hour * 60 + end_min;
+        }
         if (!get_key_bool(ini_file, "client", "stream_bundle", &config->stream_bundle, FALSE,
                           error))
                 return NULL;
+        if (!get_key_bool(ini_file, "client", "prefer_delta", &config->prefer_delta, FALSE,
+                          error))
+                return NULL;
+        if (!get_key_string(ini_file, "client", "http_version", &config->http_version, "auto",
+                            error))
+                return NULL;
+        if (g_strcmp0(config->http_version, "auto") && g_strcmp0(config->http_version, "1.1") &&
+            g_strcmp0(config->http_version, "2") &&
+            g_strcmp0(config->http_version, "2-prior-knowledge")) {
+                g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                            "Invalid 'http_version': %s (must be auto, 1.1, 2 or 2-prior-knowledge)",
+                            config->http_version);
+                return NULL;
+        }
+        if (!get_key_bool(ini_file, "client", "ssl_session_cache", &config->ssl_session_cache,
+                          TRUE, error))
+                return NULL;
+        if (!get_key_bool(ini_file, "client", "tcp_fast_open", &config->tcp_fast_open, FALSE,
+                          error))
+                return NULL;
+        if (!get_key_bool(ini_file, "client", "compress_responses", &config->compress_responses,
+                          TRUE, error))
+                return NULL;
+        if (!get_key_bool(ini_file, "client", "compress_requests", &config->compress_requests,
+                          FALSE, error))
+                return NULL;
         if (!get_key_string(ini_file, "client", "log_level", &val, DEFAULT_LOG_LEVEL, error))
                 return NULL;
         config->log_level = log_level_from_string(val);
 
+        if (!get_key_bool(ini_file, "client", "log_async", &config->log_async, FALSE, error))
+                return NULL;
+
         if (!get_key_bool(ini_file, "client", "post_update_reboot", &config->post_update_reboot, DEFAULT_REBOOT, error))
                 return NULL;
 
+        if (config->download_buffer_size < 16 * 1024 ||
+            config->download_buffer_size > 512 * 1024) {
+                g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                            "'download_buffer_size' (%d) must be between 16384 and 524288",
+                            config->download_buffer_size);
+                return NULL;
+        }
+
+        if (config->download_connections < 1 || config->download_connections > 16) {
+                g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                            "'download_connections' (%d) must be between 1 and 16",
+                            config->download_connections);
+                return NULL;
+        }
+
         if (config->timeout > 0 && config->connect_timeout > 0 &&
             config->timeout < config->connect_timeout) {
                 g_set_error(error,
@@ -339,6 +468,9 @@ void config_file_free(Config *config)
         g_free(config->auth_token);
         g_free(config->gateway_token);
         g_free(config->bundle_download_location);
+        g_free(config->bundle_cache_dir);
+        g_free(config->metrics_file);
+        g_free(config->http_version);
         if (config->device)
                 g_hash_table_destroy(config->device);
         g_free(config);
@@ -0,0 +1,116 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * SPDX-FileCopyrightText: 2022 Prevas A/S (www.prevas.com)
+ *
+ * @file
+ * @brief Streaming hash engine with build-time selectable backend: OpenSSL
+ *        EVP for SIMD/SHA instruction accelerated hashing where available,
+ *        GLib's GChecksum as portable fallback.
+ */
+
+#include "hash.h"
+#include <stddef.h>
+
+#ifdef WITH_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+
+#ifdef WITH_OPENSSL
+
+struct Hash_ {
+        EVP_MD_CTX *ctx;                           /**< EVP digest context */
+        gchar digest[EVP_MAX_MD_SIZE * 2 + 1];     /**< final digest hex string */
+        gboolean finalized;                        /**< whether digest is valid */
+};
+
+Hash* hash_new(HashType type)
+{
+        Hash *hash = g_new0(Hash, 1);
+
+        hash->ctx = EVP_MD_CTX_new();
+        g_assert_nonnull(hash->ctx);
+
+        EVP_DigestInit_ex(hash->ctx, (type == HASH_TYPE_SHA256) ? EVP_sha256() : EVP_sha1(),
+                          NULL);
+
+        return hash;
+}
+
+void hash_update(Hash *hash, const guchar *data, gsize length)
+{
+        g_return_if_fail(hash);
+        g_return_if_fail(!hash->finalized);
+
+        EVP_DigestUpdate(hash->ctx, data, length);
+}
+
+const gchar* hash_get_string(Hash *hash)
+{
+        guchar digest[EVP_MAX_MD_SIZE];
+        guint digest_len = 0, i;
+
+        g_return_val_if_fail(hash, NULL);
+
+        if (!hash->finalized) {
+                EVP_DigestFinal_ex(hash->ctx, digest, &digest_len);
+
+                for (i = 0; i < digest_len; i++)
+                        g_snprintf(hash->digest + i * 2, 3, "%02x", digest[i]);
+
+                hash->finalized = TRUE;
+        }
+
+        return hash->digest;
+}
+
+void hash_free(Hash *hash)
+{
+        if (!hash)
+                return;
+
+        EVP_MD_CTX_free(hash->ctx);
+        g_free(hash);
+}
+
+#else // fallback to GLib's GChecksum
+
+struct Hash_ {
+        GChecksum *checksum;          /**< GLib checksum context */
+};
+
+Hash* hash_new(HashType type)
+{
+        Hash *hash = g_new0(Hash, 1);
+
+        hash->checksum = g_checksum_new((type == HASH_TYPE_SHA256) ? G_CHECKSUM_SHA256
+                                        : G_CHECKSUM_SHA1);
+        g_assert_nonnull(hash->checksum);
+
+        return hash;
+}
+
+void hash_update(Hash *hash, const guchar *data, gsize length)
+{
+        g_return_if_fail(hash);
+
+        g_checksum_update(hash->checksum, data, length);
+}
+
+const gchar* hash_get_string(Hash *hash)
+{
+        g_return_val_if_fail(hash, NULL);
+
+        return g_checksum_get_string(hash->checksum);
+}
+
+void hash_free(Hash *hash)
+{
+        if (!hash)
+                return;
+
+        g_checksum_free(hash->checksum);
+        g_free(hash);
+}
+
+#endif
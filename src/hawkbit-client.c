@@ -19,6 +19,8 @@
 #include <string.h>
 #include <time.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <sys/statvfs.h>
 #include <curl/curl.h>
 #include <glib.h>
@@ -26,22 +28,35 @@
 #include <glib/gstdio.h>
 #include <json-glib/json-glib.h>
 #include <libgen.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 #include <gio/gio.h>
 #include <sys/reboot.h>
 
+#include "hash.h"
 #include "json-helper.h"
+#include "metrics.h"
 #ifdef WITH_SYSTEMD
 #include "sd-helper.h"
 #endif
 
 #include "hawkbit-client.h"
 
+static void release_curl_handle(CURL *curl);
+static void curl_share_lock_cb(CURL *handle, curl_lock_data data, curl_lock_access access,
+                               void *userptr);
+static void curl_share_unlock_cb(CURL *handle, curl_lock_data data, void *userptr);
+
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(FILE, fclose)
-G_DEFINE_AUTOPTR_CLEANUP_FUNC(CURL, curl_easy_cleanup)
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(CURL, release_curl_handle)
 
 gboolean run_once = FALSE;
 
 static const gint MAX_RETRIES_ON_API_ERROR = 10;
+static const guint MAX_POOLED_CURL_HANDLES = 4;
+static const glong IDLE_TRIM_THRESHOLD_SEC = 60;
 
 /**
  * @brief String representation of HTTP methods.
@@ -62,6 +77,9 @@ static const gint resumable_codes[] = {
         CURLE_RECV_ERROR,
         CURLE_HTTP2,
         CURLE_HTTP2_STREAM,
+        // only produced by download_rate_window_cb(): transfer aborted to
+        // resume with the rate limit of the now-active window
+        CURLE_ABORTED_BY_CALLBACK,
         0
 };
 
@@ -69,6 +87,232 @@ static Config *hawkbit_config = NULL;
 static GSourceFunc software_ready_cb;
 static struct HawkbitAction *active_action = NULL;
 static GThread *thread_download = NULL;
+static GPtrArray *curl_handle_pool = NULL;
+static GMutex curl_handle_pool_mutex;
+static GPtrArray *curl_multi_pool = NULL;
+static GMutex curl_multi_pool_mutex;
+static CURLSH *curl_share = NULL;
+static GMutex curl_share_mutexes[CURL_LOCK_DATA_LAST];
+static GMainContext *client_context = NULL;
+// whether transfers on the main context's thread may dispatch pending sources
+// while in flight; must only be set while active_action->mutex is NOT held,
+// since dispatched sources may lock it. Only the thread owning the client
+// context touches the flag - callbacks that can also run on other threads
+// (direct single-shot progress flush) must check ownership first
+static gboolean context_dispatch_allowed = FALSE;
+static GPtrArray *progress_queue = NULL;
+static GMutex progress_queue_mutex;
+static gboolean progress_flush_pending = FALSE;
+// streaming install telemetry, guarded by progress_queue_mutex: with
+// stream_bundle, RAUC downloads the bundle itself, throughput is derived from
+// its percentage progress against the artifact size
+static gint64 stream_install_size = 0;
+static gint64 stream_install_started_at = 0;
+// multi-artifact deployment pipeline state, guarded by active_action->mutex
+static gboolean install_in_flight = FALSE;
+static gboolean last_install_success = FALSE;
+static guint artifacts_pending = 0;
+
+/**
+ * @brief Initialize libcurl and the process-wide share object on first use.
+ *        Lazy initialization keeps no-op invocations (run_once polls without
+ *        new software) from paying the full curl setup cost up front.
+ */
+static void ensure_curl_initialized(void)
+{
+        static gsize initialized = 0;
+
+        if (g_once_init_enter(&initialized)) {
+                curl_global_init(CURL_GLOBAL_ALL);
+
+                // share DNS, TLS session and connection caches across all handles
+                curl_share = curl_share_init();
+                if (curl_share) {
+                        curl_share_setopt(curl_share, CURLSHOPT_LOCKFUNC, curl_share_lock_cb);
+                        curl_share_setopt(curl_share, CURLSHOPT_UNLOCKFUNC,
+                                          curl_share_unlock_cb);
+                        curl_share_setopt(curl_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                        curl_share_setopt(curl_share, CURLSHOPT_SHARE,
+                                          CURL_LOCK_DATA_SSL_SESSION);
+#if CURL_AT_LEAST_VERSION(7, 57, 0)
+                        curl_share_setopt(curl_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+                }
+
+                g_once_init_leave(&initialized, 1);
+        }
+}
+
+/**
+ * @brief Take a Curl handle from the pool or create a new one. Pooled handles
+ *        are reused including their connection, TLS session and DNS caches, so
+ *        consecutive requests avoid repeated TCP/TLS handshakes.
+ *
+ * @param[out] error Error
+ * @return Curl handle on success, NULL otherwise (error set). Must be given
+ *         back via release_curl_handle().
+ */
+static CURL *acquire_curl_handle(GError **error)
+{
+        CURL *curl = NULL;
+
+        g_return_val_if_fail(error == NULL || *error == NULL, NULL);
+
+        ensure_curl_initialized();
+
+        g_mutex_lock(&curl_handle_pool_mutex);
+        if (curl_handle_pool && curl_handle_pool->len)
+                curl = g_ptr_array_remove_index(curl_handle_pool,
+                                                curl_handle_pool->len - 1);
+        g_mutex_unlock(&curl_handle_pool_mutex);
+
+        if (!curl)
+                curl = curl_easy_init();
+
+        if (!curl)
+                g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, CURLE_FAILED_INIT,
+                            "Unable to start libcurl easy session");
+
+        return curl;
+}
+
+/**
+ * @brief Return a Curl handle to the pool, to be reused by the next request.
+ *        The handle's options are reset, its caches (connections, TLS
+ *        sessions, DNS) are kept. Excess handles are cleaned up.
+ *
+ * @param[in] curl Curl handle to release or NULL
+ */
+static void release_curl_handle(CURL *curl)
+{
+        if (!curl)
+                return;
+
+        curl_easy_reset(curl);
+
+        g_mutex_lock(&curl_handle_pool_mutex);
+        if (curl_handle_pool && curl_handle_pool->len < MAX_POOLED_CURL_HANDLES) {
+                g_ptr_array_add(curl_handle_pool, curl);
+                curl = NULL;
+        }
+        g_mutex_unlock(&curl_handle_pool_mutex);
+
+        if (curl)
+                curl_easy_cleanup(curl);
+}
+
+/**
+ * @brief Take a Curl multi handle from the pool or create a new one. Multi
+ *        handles own the connection cache of transfers driven through them,
+ *        pooling them keeps connections alive across requests.
+ *
+ * @return Curl multi handle on success, NULL otherwise. Must be given back via
+ *         release_curl_multi_handle().
+ */
+static CURLM *acquire_curl_multi_handle(void)
+{
+        CURLM *multi = NULL;
+
+        ensure_curl_initialized();
+
+        g_mutex_lock(&curl_multi_pool_mutex);
+        if (curl_multi_pool && curl_multi_pool->len)
+                multi = g_ptr_array_remove_index(curl_multi_pool,
+                                                 curl_multi_pool->len - 1);
+        g_mutex_unlock(&curl_multi_pool_mutex);
+
+        if (!multi) {
+                multi = curl_multi_init();
+
+                // allow multiplexing transfers over one connection (HTTP/2)
+                if (multi)
+                        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        }
+
+        return multi;
+}
+
+/**
+ * @brief Return a Curl multi handle to the pool, to be reused by the next
+ *        transfer. Excess handles are cleaned up.
+ *
+ * @param[in] multi Curl multi handle to release or NULL
+ */
+static void release_curl_multi_handle(CURLM *multi)
+{
+        if (!multi)
+                return;
+
+        g_mutex_lock(&curl_multi_pool_mutex);
+        if (curl_multi_pool && curl_multi_pool->len < MAX_POOLED_CURL_HANDLES) {
+                g_ptr_array_add(curl_multi_pool, multi);
+                multi = NULL;
+        }
+        g_mutex_unlock(&curl_multi_pool_mutex);
+
+        if (multi)
+                curl_multi_cleanup(multi);
+}
+
+/**
+ * @brief Drop-in replacement for curl_easy_perform(), driving the transfer
+ *        through a Curl multi handle. When called on the thread running the
+ *        client's main context, other main loop sources (systemd watchdog,
+ *        scheduled callbacks) are dispatched while the transfer is in flight,
+ *        so a slow server cannot stall them for the transfer duration.
+ *
+ * @param[in] curl Curl handle with all transfer options set
+ * @return CURLcode of the completed transfer
+ */
+static CURLcode perform_curl_transfer(CURL *curl)
+{
+        CURLM *multi = NULL;
+        CURLMsg *msg = NULL;
+        CURLcode res = CURLE_FAILED_INIT;
+        int still_running = 0, msgs_left = 0;
+
+        g_return_val_if_fail(curl, CURLE_FAILED_INIT);
+
+        multi = acquire_curl_multi_handle();
+        if (!multi)
+                return CURLE_FAILED_INIT;
+
+        if (curl_multi_add_handle(multi, curl) != CURLM_OK) {
+                release_curl_multi_handle(multi);
+                return CURLE_FAILED_INIT;
+        }
+
+        while (1) {
+                int numfds = 0;
+
+                if (curl_multi_perform(multi, &still_running) != CURLM_OK)
+                        break;
+
+                if (!still_running)
+                        break;
+
+                // keep dispatching pending main loop sources during the transfer
+                if (context_dispatch_allowed && client_context &&
+                    g_main_context_is_owner(client_context))
+                        while (g_main_context_iteration(client_context, FALSE));
+
+                if (curl_multi_wait(multi, NULL, 0, 100, &numfds) != CURLM_OK)
+                        break;
+
+                // no active sockets yet (e.g. during connect), avoid busy looping
+                if (!numfds)
+                        g_usleep(100000);
+        }
+
+        while ((msg = curl_multi_info_read(multi, &msgs_left)))
+                if (msg->msg == CURLMSG_DONE && msg->easy_handle == curl)
+                        res = msg->data.result;
+
+        curl_multi_remove_handle(multi, curl);
+        release_curl_multi_handle(multi);
+
+        return res;
+}
 
 GQuark rhu_hawkbit_client_error_quark(void)
 {
@@ -102,6 +346,88 @@ static struct HawkbitAction *action_new(void)
         return action;
 }
 
+/**
+ * @brief Build path of the action journal file, stored next to the bundle
+ *        download location.
+ *
+ * @return Newly allocated journal path, NULL if no bundle_download_location
+ *         is configured (streaming setups have nothing to resume locally)
+ */
+static gchar* action_journal_path(void)
+{
+        if (!hawkbit_config->bundle_download_location)
+                return NULL;
+
+        return g_strdup_printf("%s.state", hawkbit_config->bundle_download_location);
+}
+
+/**
+ * @brief Persist the active action's id and state to the journal file
+ *        (atomically via temp file + rename), so a restarted daemon continues
+ *        the deployment instead of wiping the partial download.
+ *        Must be called under locked active_action->mutex.
+ */
+static void action_journal_save_locked(void)
+{
+        g_autofree gchar *path = action_journal_path();
+        g_autofree gchar *data = NULL;
+        g_autoptr(GKeyFile) key_file = NULL;
+        g_autoptr(GError) error = NULL;
+        gsize length = 0;
+
+        if (!path || !active_action->id)
+                return;
+
+        key_file = g_key_file_new();
+        g_key_file_set_string(key_file, "action", "id", active_action->id);
+        g_key_file_set_integer(key_file, "action", "state", active_action->state);
+
+        data = g_key_file_to_data(key_file, &length, NULL);
+        if (!g_file_set_contents(path, data, length, &error))
+                g_debug("Failed to write action journal %s: %s", path, error->message);
+}
+
+/**
+ * @brief Delete the action journal file (if any), to be called when the
+ *        active action closes.
+ */
+static void action_journal_remove(void)
+{
+        g_autofree gchar *path = action_journal_path();
+
+        if (!path || !g_file_test(path, G_FILE_TEST_IS_REGULAR))
+                return;
+
+        if (g_remove(path))
+                g_warning("Failed to delete action journal %s", path);
+}
+
+/**
+ * @brief Restore the action id recorded in the journal file (if any), letting
+ *        the next poll continue the recorded deployment: a matching id skips
+ *        the bundle cleanup and resumes the download from the existing file.
+ */
+static void action_journal_load(void)
+{
+        g_autofree gchar *path = action_journal_path();
+        g_autofree gchar *id = NULL;
+        g_autoptr(GKeyFile) key_file = NULL;
+
+        if (!path || !g_file_test(path, G_FILE_TEST_IS_REGULAR))
+                return;
+
+        key_file = g_key_file_new();
+        if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, NULL))
+                return;
+
+        id = g_key_file_get_string(key_file, "action", "id", NULL);
+        if (!id)
+                return;
+
+        g_message("Resuming action %s recorded in journal", id);
+        active_action->id = g_steal_pointer(&id);
+}
+
 /**
  * @brief Get available free space of a mounted file system.
  *
@@ -131,27 +457,186 @@ static gboolean get_available_space(const char *path, goffset *free_space, GErro
 }
 
 /**
- * @brief Calculate checksum for file.
+ * @brief Evict least-recently-used bundle cache entries until the cache total
+ *        plus reserve bytes fits the configured budget and free_needed bytes
+ *        are available on the cache file system.
  *
- * @param[in]  fp       File to read data from
- * @param[in]  type     Desired type of checksum
- * @param[out] checksum Calculated checksum digest hex string
- * @param[out] error    Error
- * @return TRUE if checksum calculation succeeded, FALSE otherwise (error set)
+ * @param[in] reserve     Bytes about to be added to the cache
+ * @param[in] free_needed Bytes of free space required on the file system, 0
+ *                        to only enforce the budget
  */
-static gboolean get_file_checksum(FILE *fp, const GChecksumType type, gchar **checksum,
-                                  GError **error)
+static void bundle_cache_evict(goffset reserve, goffset free_needed)
+{
+        while (1) {
+                g_autoptr(GDir) dir = NULL;
+                g_autofree gchar *oldest = NULL;
+                const gchar *name = NULL;
+                goffset total = 0, freespace = 0;
+                time_t oldest_mtime = 0;
+                gboolean over_budget, out_of_space = FALSE;
+
+                dir = g_dir_open(hawkbit_config->bundle_cache_dir, 0, NULL);
+                if (!dir)
+                        return;
+
+                while ((name = g_dir_read_name(dir))) {
+                        g_autofree gchar *path = g_build_filename(
+                                hawkbit_config->bundle_cache_dir, name, NULL);
+                        GStatBuf entry_stat;
+
+                        if (g_stat(path, &entry_stat) || !S_ISREG(entry_stat.st_mode))
+                                continue;
+
+                        total += entry_stat.st_size;
+
+                        if (!oldest || entry_stat.st_mtime < oldest_mtime) {
+                                g_free(oldest);
+                                oldest = g_steal_pointer(&path);
+                                oldest_mtime = entry_stat.st_mtime;
+                        }
+                }
+
+                over_budget = hawkbit_config->bundle_cache_size > 0 &&
+                              total + reserve > hawkbit_config->bundle_cache_size;
+
+                if (free_needed) {
+                        g_autofree gchar *probe = g_build_filename(
+                                hawkbit_config->bundle_cache_dir, "probe", NULL);
+
+                        out_of_space = get_available_space(probe, &freespace, NULL) &&
+                                       freespace < free_needed;
+                }
+
+                if ((!over_budget && !out_of_space) || !oldest)
+                        return;
+
+                g_debug("Evicting cached bundle %s", oldest);
+                if (g_remove(oldest))
+                        return;
+        }
+}
+
+/**
+ * @brief Link (or copy) a cached bundle matching sha1 to dest, refreshing its
+ *        cache timestamp for LRU accounting.
+ *
+ * @param[in] sha1 sha1 checksum of the wanted bundle
+ * @param[in] dest Destination path
+ * @return TRUE if dest was provided from the cache, FALSE otherwise
+ */
+static gboolean bundle_cache_get(const gchar *sha1, const gchar *dest)
+{
+        g_autofree gchar *path = NULL;
+
+        if (!hawkbit_config->bundle_cache_dir || !sha1)
+                return FALSE;
+
+        path = g_build_filename(hawkbit_config->bundle_cache_dir, sha1, NULL);
+        if (!g_file_test(path, G_FILE_TEST_IS_REGULAR))
+                return FALSE;
+
+        (void) g_remove(dest);
+
+        if (link(path, dest)) {
+                // different file system, fall back to copying
+                g_autoptr(GFile) cache_file = g_file_new_for_path(path);
+                g_autoptr(GFile) dest_file = g_file_new_for_path(dest);
+
+                if (!g_file_copy(cache_file, dest_file, G_FILE_COPY_OVERWRITE, NULL, NULL, NULL,
+                                 NULL))
+                        return FALSE;
+        }
+
+        g_utime(path, NULL);
+
+        return TRUE;
+}
+
+/**
+ * @brief Drop the cache entry for sha1 (e.g. when its content turned out to
+ *        be corrupt).
+ *
+ * @param[in] sha1 sha1 checksum of the entry to drop
+ */
+static void bundle_cache_drop(const gchar *sha1)
+{
+        g_autofree gchar *path = NULL;
+
+        if (!hawkbit_config->bundle_cache_dir || !sha1)
+                return;
+
+        path = g_build_filename(hawkbit_config->bundle_cache_dir, sha1, NULL);
+        (void) g_remove(path);
+}
+
+/**
+ * @brief Retain a verified downloaded bundle in the cache, keyed by its sha1,
+ *        evicting older entries to stay within the configured budget.
+ *        Hardlinked where possible, so retention is free on the common
+ *        single-file-system setup.
+ *
+ * @param[in] sha1 sha1 checksum of the bundle
+ * @param[in] file Verified bundle file
+ */
+static void bundle_cache_put(const gchar *sha1, const gchar *file)
+{
+        g_autofree gchar *path = NULL;
+        GStatBuf bundle_stat;
+
+        if (!hawkbit_config->bundle_cache_dir || !sha1)
+                return;
+
+        if (g_mkdir_with_parents(hawkbit_config->bundle_cache_dir, 0700)) {
+                g_warning("Failed to create bundle cache directory %s",
+                          hawkbit_config->bundle_cache_dir);
+                return;
+        }
+
+        path = g_build_filename(hawkbit_config->bundle_cache_dir, sha1, NULL);
+        if (g_file_test(path, G_FILE_TEST_IS_REGULAR)) {
+                g_utime(path, NULL);
+                return;
+        }
+
+        if (g_stat(file, &bundle_stat))
+                return;
+
+        bundle_cache_evict(bundle_stat.st_size, 0);
+
+        if (link(file, path)) {
+                // different file system, fall back to copying
+                g_autoptr(GFile) bundle_file = g_file_new_for_path(file);
+                g_autoptr(GFile) cache_file = g_file_new_for_path(path);
+
+                if (!g_file_copy(bundle_file, cache_file, G_FILE_COPY_OVERWRITE, NULL, NULL,
+                                 NULL, NULL)) {
+                        g_warning("Failed to cache bundle %s", path);
+                        return;
+                }
+        }
+
+        g_debug("Cached bundle as %s", path);
+}
+
+/**
+ * @brief Feed existing file contents into hash context, from the beginning
+ *        of the file up to EOF. Used to account for an already downloaded
+ *        prefix when resuming a download.
+ *
+ * @param[in]  ctx   Hash context to update
+ * @param[in]  fp    File to read data from
+ * @param[out] error Error
+ * @return TRUE if checksum update succeeded, FALSE otherwise (error set)
+ */
+static gboolean checksum_file_prefix(Hash *ctx, FILE *fp, GError **error)
 {
-        g_autoptr(GChecksum) ctx = g_checksum_new(type);
         guchar buf[4096];
         size_t r;
 
+        g_return_val_if_fail(ctx, FALSE);
         g_return_val_if_fail(fp, FALSE);
-        g_return_val_if_fail(checksum && *checksum == NULL, FALSE);
         g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-        g_assert_nonnull(ctx);
-
         fseek(fp, 0, SEEK_SET);
 
         while (1) {
@@ -161,14 +646,12 @@ static gboolean get_file_checksum(FILE *fp, const GChecksumType type, gchar **ch
                         return FALSE;
                 }
 
-                g_checksum_update(ctx, buf, r);
+                hash_update(ctx, buf, r);
 
                 if (feof(fp))
                         break;
         }
 
-        *checksum = g_strdup(g_checksum_get_string(ctx));
-
         return TRUE;
 }
 
@@ -213,163 +696,903 @@ static char* get_auth_header()
                 return g_strdup_printf("Authorization: TargetToken %s",
                                        hawkbit_config->auth_token);
 
-        if (hawkbit_config->gateway_token)
-                return g_strdup_printf("Authorization: GatewayToken %s",
-                                       hawkbit_config->gateway_token);
+        if (hawkbit_config->gateway_token)
+                return g_strdup_printf("Authorization: GatewayToken %s",
+                                       hawkbit_config->gateway_token);
+
+        g_return_val_if_reached(NULL);
+}
+
+/**
+ * @brief Add hawkBit authorization header to Curl headers.
+ *
+ * @param[out] headers curl_slist** of already set headers
+ * @param[out] error   Error
+ * @return TRUE if authorization method set in config and header was added successfully, TRUE if no
+ *         authorization method set, FALSE otherwise (error set)
+ */
+static gboolean set_auth_curl_header(struct curl_slist **headers, GError **error)
+{
+        gboolean res = TRUE;
+        g_autofree gchar *token = NULL;
+
+        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+        token = get_auth_header();
+        if (token)
+                res = add_curl_header(headers, token, error);
+
+        return res;
+}
+
+/**
+ * @brief Curl share interface lock callback, handles live on different
+ *        threads (main loop, download/segment threads).
+ *
+ * @see https://curl.haxx.se/libcurl/c/CURLSHOPT_LOCKFUNC.html
+ */
+static void curl_share_lock_cb(CURL *handle, curl_lock_data data, curl_lock_access access,
+                               void *userptr)
+{
+        g_mutex_lock(&curl_share_mutexes[data]);
+}
+
+/**
+ * @brief Curl share interface unlock callback.
+ *
+ * @see https://curl.haxx.se/libcurl/c/CURLSHOPT_UNLOCKFUNC.html
+ */
+static void curl_share_unlock_cb(CURL *handle, curl_lock_data data, void *userptr)
+{
+        g_mutex_unlock(&curl_share_mutexes[data]);
+}
+
+/**
+ * @brief Set common Curl options, namely user agent, connect timeout, SSL
+ *        verify peer and SSL verify host options, and attach the process-wide
+ *        share object (DNS, TLS session and connection caches).
+ *
+ * @param[in] curl Curl handle
+ */
+static void set_default_curl_opts(CURL *curl)
+{
+        g_return_if_fail(curl);
+
+        if (curl_share)
+                curl_easy_setopt(curl, CURLOPT_SHARE, curl_share);
+
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, HAWKBIT_USERAGENT);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, hawkbit_config->connect_timeout);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, hawkbit_config->ssl_verify ? 1L : 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, hawkbit_config->ssl_verify ? 1L : 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_SESSIONID_CACHE,
+                         hawkbit_config->ssl_session_cache ? 1L : 0L);
+
+        if (!g_strcmp0(hawkbit_config->http_version, "1.1"))
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+        else if (!g_strcmp0(hawkbit_config->http_version, "2"))
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#if CURL_AT_LEAST_VERSION(7, 49, 0)
+        else if (!g_strcmp0(hawkbit_config->http_version, "2-prior-knowledge"))
+                curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+                                 CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+
+        if (hawkbit_config->tcp_fast_open)
+                curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
+#endif
+}
+
+// flush and drop written data from the page cache in steps of this size
+#define DOWNLOAD_FADVISE_CHUNK (8 * 1024 * 1024)
+
+/**
+ * @brief Context for get_binary_write_cb(), bundling download destination and
+ *        streaming checksum context.
+ */
+struct get_binary_ctx {
+        int fd;                       /**< descriptor the download is written to */
+        Hash *checksum;               /**< hash updated with downloaded data or NULL */
+        curl_off_t written;           /**< absolute bytes present in the file */
+        curl_off_t advised;           /**< bytes already dropped from the page cache */
+};
+
+/**
+ * @brief Curl callback writing downloaded data straight to the file
+ *        descriptor (no stdio buffer copy) and feeding it into the streaming
+ *        checksum context (if enabled), so no second full read pass is
+ *        required for verification. Written ranges are dropped from the page
+ *        cache in large steps, so a big bundle does not evict it wholesale.
+ *
+ * @see   https://curl.haxx.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
+ */
+static size_t get_binary_write_cb(const void *content, size_t size, size_t nmemb, void *data)
+{
+        struct get_binary_ctx *ctx = NULL;
+        size_t real_size = size * nmemb;
+        size_t done = 0;
+
+        g_return_val_if_fail(content, 0);
+        g_return_val_if_fail(data, 0);
+
+        ctx = (struct get_binary_ctx *) data;
+
+        while (done < real_size) {
+                ssize_t written = write(ctx->fd, (const gchar *) content + done,
+                                        real_size - done);
+
+                if (written < 0) {
+                        if (errno == EINTR)
+                                continue;
+
+                        return 0; // aborts the transfer with CURLE_WRITE_ERROR
+                }
+
+                done += written;
+        }
+
+        if (ctx->checksum)
+                hash_update(ctx->checksum, content, real_size);
+
+        ctx->written += real_size;
+
+        if (ctx->written - ctx->advised >= DOWNLOAD_FADVISE_CHUNK) {
+                fdatasync(ctx->fd);
+                posix_fadvise(ctx->fd, ctx->advised, ctx->written - ctx->advised,
+                              POSIX_FADV_DONTNEED);
+                ctx->advised = ctx->written;
+        }
+
+        return real_size;
+}
+
+/**
+ * @brief Get the download rate ceiling currently in effect. With a configured
+ *        rate_limit_window the ceiling only applies inside the window (e.g.
+ *        trickle during business hours, full speed at night).
+ *
+ * @return rate limit in bytes/s, 0 for unlimited
+ */
+static curl_off_t current_download_rate_limit(void)
+{
+        struct tm time_info;
+        time_t current_time;
+        gint minutes, start, end;
+        gboolean in_window;
+
+        if (!hawkbit_config->max_download_rate)
+                return 0;
+
+        start = hawkbit_config->rate_limit_window_start;
+        end = hawkbit_config->rate_limit_window_end;
+
+        if (start < 0)
+                return hawkbit_config->max_download_rate;
+
+        time(&current_time);
+        localtime_r(&current_time, &time_info);
+        minutes = time_info.tm_hour * 60 + time_info.tm_min;
+
+        // window may cross midnight
+        in_window = (start <= end) ? (minutes >= start && minutes < end)
+                    : (minutes >= start || minutes < end);
+
+        return in_window ? hawkbit_config->max_download_rate : 0;
+}
+
+/**
+ * @brief Context for download_rate_window_cb().
+ */
+struct rate_limit_ctx {
+        curl_off_t applied;           /**< rate limit the running transfer was started with */
+        gint64 next_check;            /**< monotonic time of the next window check */
+};
+
+/**
+ * @brief Curl progress callback aborting the transfer when the configured
+ *        rate limit window opens or closes during a long download, so the
+ *        resume picks up the transfer with the now-effective limit. Only
+ *        installed when resuming is possible.
+ *
+ * @see https://curl.haxx.se/libcurl/c/CURLOPT_XFERINFOFUNCTION.html
+ */
+static int download_rate_window_cb(void *clientp, curl_off_t dltotal, curl_off_t dlnow,
+                                   curl_off_t ultotal, curl_off_t ulnow)
+{
+        struct rate_limit_ctx *ctx = clientp;
+        gint64 now = g_get_monotonic_time();
+
+        if (now < ctx->next_check)
+                return 0;
+
+        ctx->next_check = now + 30 * G_USEC_PER_SEC;
+
+        if (current_download_rate_limit() != ctx->applied)
+                return 1; // aborts the transfer with CURLE_ABORTED_BY_CALLBACK
+
+        return 0;
+}
+
+/**
+ * @brief Reserve the full expected file size on disk up front (keeping the
+ *        apparent file size, so resume-from-size logic is unaffected). This
+ *        turns the free space check into a hard reservation and yields
+ *        contiguous extents for faster sequential reads later.
+ *
+ * @param[in]  fp        File to preallocate
+ * @param[in]  file      File name, used in error message
+ * @param[in]  offset    Offset to reserve from (already present bytes)
+ * @param[in]  file_size Expected total file size in bytes
+ * @param[out] error     Error
+ * @return TRUE if space was reserved or preallocation is unsupported, FALSE
+ *         if the file system is out of space (error set)
+ */
+static gboolean preallocate_file(FILE *fp, const gchar *file, curl_off_t offset,
+                                 curl_off_t file_size, GError **error)
+{
+        g_return_val_if_fail(fp, FALSE);
+        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+        if (file_size <= offset)
+                return TRUE;
+
+        if (fallocate(fileno(fp), FALLOC_FL_KEEP_SIZE, offset, file_size - offset)) {
+                int err = errno;
+
+                if (err == ENOSPC) {
+                        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOSPC,
+                                    "Failed to preallocate %s: %s", file, g_strerror(err));
+                        return FALSE;
+                }
+
+                // not supported on this file system, non-fatal
+                g_debug("Could not preallocate %s: %s", file, g_strerror(err));
+        }
+
+        return TRUE;
+}
+
+/**
+ * @brief Download download_url to file.
+ *
+ * @param[in]  download_url URL to download from
+ * @param[in]  file         Download destination
+ * @param[in]  resume_from  Offset to resume download from
+ * @param[in]  file_size    Expected file size for preallocation, 0 if unknown
+ * @param[in]  hash_type    Type of checksum to calculate
+ * @param[out] checksum_out Calculated checksum or NULL
+ * @param[out] speed        Average download speed
+ * @param[out] error        Error
+ * @return TRUE if download succeeded, FALSE otherwise (error set)
+ */
+gboolean get_binary(const gchar *download_url, const gchar *file, curl_off_t resume_from,
+                    curl_off_t file_size, HashType hash_type, gchar **checksum_out,
+                    curl_off_t *speed, GError **error)
+{
+        g_autoptr(CURL) curl = NULL;
+        g_autoptr(FILE) fp = NULL;
+        g_autoptr(Hash) checksum = NULL;
+        struct get_binary_ctx write_ctx;
+        struct rate_limit_ctx rate_ctx;
+        curl_off_t rate_limit;
+        CURLcode curl_code;
+        glong http_code = 0;
+        struct curl_slist *headers = NULL;
+
+        g_return_val_if_fail(download_url, FALSE);
+        g_return_val_if_fail(file, FALSE);
+        g_return_val_if_fail(checksum_out == NULL || *checksum_out == NULL, FALSE);
+        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+        if (resume_from)
+                g_debug("Resuming download from offset %" CURL_FORMAT_CURL_OFF_T, resume_from);
+
+        fp = g_fopen(file, (resume_from) ? "ab+" : "wb+");
+        if (!fp) {
+                int err = errno;
+                g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_FAILED,
+                            "Failed to open %s for download: %s", file, g_strerror(err));
+                return FALSE;
+        }
+
+        if (!preallocate_file(fp, file, resume_from, file_size, error))
+                return FALSE;
+
+        // hash downloaded data on the fly, hash already downloaded prefix on resume
+        if (checksum_out) {
+                checksum = hash_new(hash_type);
+
+                if (resume_from && !checksum_file_prefix(checksum, fp, error))
+                        return FALSE;
+        }
+
+        // the write callback bypasses stdio and writes to the descriptor
+        // directly; fp is only used for prefix hashing and cleanup
+        write_ctx.fd = fileno(fp);
+        write_ctx.checksum = checksum;
+        write_ctx.written = resume_from;
+        write_ctx.advised = resume_from;
+
+        curl = acquire_curl_handle(error);
+        if (!curl)
+                return FALSE;
+
+        set_default_curl_opts(curl);
+        curl_easy_setopt(curl, CURLOPT_URL, download_url);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 8L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, get_binary_write_cb);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &write_ctx);
+        curl_easy_setopt(curl, CURLOPT_BUFFERSIZE,
+                         (glong) hawkbit_config->download_buffer_size);
+
+        // abort if slower than configured download rate during configured time span
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, hawkbit_config->low_speed_time);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, hawkbit_config->low_speed_rate);
+
+        // cap download rate (0 = unlimited)
+        rate_limit = current_download_rate_limit();
+        curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE, rate_limit);
+
+        // re-apply the cap via abort-and-resume when the rate window flips
+        // mid-transfer; without resume support the cap stays as sampled at
+        // transfer start
+        if (hawkbit_config->rate_limit_window_start >= 0 &&
+            hawkbit_config->resume_downloads) {
+                rate_ctx.applied = rate_limit;
+                rate_ctx.next_check = g_get_monotonic_time() + 30 * G_USEC_PER_SEC;
+                curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, download_rate_window_cb);
+                curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &rate_ctx);
+                curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        }
+
+        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, resume_from);
+
+        if (!set_auth_curl_header(&headers, error))
+                return FALSE;
+
+        // set up request headers
+        if (!add_curl_header(&headers, "Accept: application/octet-stream", error))
+                return FALSE;
+
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+        // perform transfer
+        curl_code = perform_curl_transfer(curl);
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD_T, speed);
+        metrics_record_transfer(curl, TRUE);
+        curl_slist_free_all(headers);
+
+        if (curl_code != CURLE_OK) {
+                g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, curl_code, "%s",
+                            curl_easy_strerror(curl_code));
+                return FALSE;
+        }
+        // consider ok/partial download/range not satisfiable (EOF reached) as success
+        if (http_code != 200 && http_code != 206 && http_code != 416) {
+                g_set_error(error, RHU_HAWKBIT_CLIENT_HTTP_ERROR, http_code,
+                            "HTTP request failed: %ld", http_code);
+                return FALSE;
+        }
+
+        // if checksum enabled then return the value computed during download
+        if (checksum_out)
+                *checksum_out = g_strdup(hash_get_string(checksum));
+
+        return TRUE;
+}
+
+/**
+ * @brief Per-connection state of a parallel range download.
+ */
+struct download_segment {
+        const gchar *download_url;    /**< URL to download from */
+        int fd;                       /**< destination file descriptor, shared by all segments */
+        curl_off_t offset;            /**< absolute start offset of this segment */
+        curl_off_t size;              /**< segment size in bytes */
+        curl_off_t written;           /**< bytes written so far, advanced on retries */
+        curl_off_t advised;           /**< bytes already dropped from the page cache */
+        GError *error;                /**< set if the segment failed */
+};
+
+/**
+ * @brief Curl callback writing range downloaded data at the segment's current
+ *        offset via pwrite(), safe to run concurrently on a shared
+ *        descriptor.
+ *
+ * @see   https://curl.haxx.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
+ */
+static size_t download_segment_write_cb(const void *content, size_t size, size_t nmemb,
+                                        void *data)
+{
+        struct download_segment *segment = NULL;
+        size_t real_size = size * nmemb;
+        size_t done = 0;
+
+        g_return_val_if_fail(content, 0);
+        g_return_val_if_fail(data, 0);
+
+        segment = (struct download_segment *) data;
+
+        while (done < real_size) {
+                ssize_t written = pwrite(segment->fd, (const gchar *) content + done,
+                                         real_size - done, segment->offset + segment->written);
+
+                if (written < 0) {
+                        if (errno == EINTR)
+                                continue;
+
+                        return 0; // aborts the transfer with CURLE_WRITE_ERROR
+                }
+
+                done += written;
+                segment->written += written;
+        }
+
+        if (segment->written - segment->advised >= DOWNLOAD_FADVISE_CHUNK) {
+                fdatasync(segment->fd);
+                posix_fadvise(segment->fd, segment->offset + segment->advised,
+                              segment->written - segment->advised, POSIX_FADV_DONTNEED);
+                segment->advised = segment->written;
+        }
+
+        return real_size;
+}
+
+/**
+ * @brief Thread downloading one segment of a parallel range download,
+ *        retrying/resuming the segment on resumable Curl errors.
+ *
+ * @param[in] data struct download_segment* to process
+ * @return NULL is always returned, the result is stored in the segment's
+ *         error member
+ */
+static gpointer download_segment_thread(gpointer data)
+{
+        struct download_segment *segment = data;
+
+        g_return_val_if_fail(data, NULL);
+
+        while (1) {
+                g_autoptr(CURL) curl = NULL;
+                g_autofree gchar *range = NULL;
+                struct curl_slist *headers = NULL;
+                struct rate_limit_ctx rate_ctx;
+                curl_off_t rate_limit;
+                gboolean resumable = FALSE;
+                const gint *code;
+                CURLcode curl_code;
+                glong http_code = 0;
+
+                curl = acquire_curl_handle(&segment->error);
+                if (!curl)
+                        return NULL;
+
+                set_default_curl_opts(curl);
+                curl_easy_setopt(curl, CURLOPT_URL, segment->download_url);
+                curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+                curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 8L);
+                curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, download_segment_write_cb);
+                curl_easy_setopt(curl, CURLOPT_WRITEDATA, segment);
+                curl_easy_setopt(curl, CURLOPT_BUFFERSIZE,
+                                 (glong) hawkbit_config->download_buffer_size);
+
+                // abort if slower than configured download rate during configured time span
+                curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, hawkbit_config->low_speed_time);
+                curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, hawkbit_config->low_speed_rate);
+
+                // cap download rate per connection (0 = unlimited)
+                rate_limit = current_download_rate_limit();
+                curl_easy_setopt(curl, CURLOPT_MAX_RECV_SPEED_LARGE, rate_limit);
+
+                // re-apply the cap via abort-and-resume when the rate window
+                // flips mid-transfer (segment retries honor resume_downloads)
+                if (hawkbit_config->rate_limit_window_start >= 0 &&
+                    hawkbit_config->resume_downloads) {
+                        rate_ctx.applied = rate_limit;
+                        rate_ctx.next_check = g_get_monotonic_time() + 30 * G_USEC_PER_SEC;
+                        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION,
+                                         download_rate_window_cb);
+                        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &rate_ctx);
+                        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+                }
+
+                range = g_strdup_printf("%" CURL_FORMAT_CURL_OFF_T "-%" CURL_FORMAT_CURL_OFF_T,
+                                        segment->offset + segment->written,
+                                        segment->offset + segment->size - 1);
+                curl_easy_setopt(curl, CURLOPT_RANGE, range);
+
+                if (!set_auth_curl_header(&headers, &segment->error))
+                        return NULL;
+
+                if (!add_curl_header(&headers, "Accept: application/octet-stream",
+                                     &segment->error))
+                        return NULL;
+
+                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+                curl_code = perform_curl_transfer(curl);
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+                metrics_record_transfer(curl, TRUE);
+                curl_slist_free_all(headers);
+
+                if (curl_code == CURLE_OK) {
+                        // a server ignoring the Range header would corrupt the file
+                        if (http_code != 206) {
+                                g_set_error(&segment->error, RHU_HAWKBIT_CLIENT_HTTP_ERROR,
+                                            http_code,
+                                            "HTTP range request failed (no partial content): %ld",
+                                            http_code);
+                                return NULL;
+                        }
+
+                        if (segment->written >= segment->size)
+                                return NULL;
+
+                        // short but successful range response, fetch the rest
+                        continue;
+                }
+
+                for (code = &resumable_codes[0]; *code; code++)
+                        resumable |= (curl_code == *code);
+
+                if (!hawkbit_config->resume_downloads || !resumable) {
+                        g_set_error(&segment->error, RHU_HAWKBIT_CLIENT_CURL_ERROR, curl_code,
+                                    "%s", curl_easy_strerror(curl_code));
+                        return NULL;
+                }
+
+                g_debug("%s, resuming segment download..", curl_easy_strerror(curl_code));
+
+                // sleep 0.5 s before attempting to resume segment download
+                g_usleep(500000);
+        }
+}
+
+/**
+ * @brief Download download_url to file over multiple concurrent range
+ *        requests, one per configured connection.
+ *
+ * @param[in]  download_url URL to download from
+ * @param[in]  file         Download destination
+ * @param[in]  total_size   Artifact size in bytes
+ * @param[in]  connections  Number of concurrent connections
+ * @param[in]  hash_type    Type of checksum to calculate
+ * @param[out] checksum_out Calculated checksum or NULL
+ * @param[out] speed        Average download speed
+ * @param[out] error        Error
+ * @return TRUE if download succeeded, FALSE otherwise (error set)
+ */
+static gboolean get_binary_parallel(const gchar *download_url, const gchar *file,
+                                    curl_off_t total_size, gint connections,
+                                    HashType hash_type, gchar **checksum_out, curl_off_t *speed,
+                                    GError **error)
+{
+        g_autofree struct download_segment *segments = NULL;
+        g_autofree GThread **threads = NULL;
+        g_autoptr(FILE) fp = NULL;
+        GError *segment_error = NULL;
+        curl_off_t segment_size;
+        gint64 elapsed_usec, start_time;
+        gint i;
+
+        g_return_val_if_fail(download_url, FALSE);
+        g_return_val_if_fail(file, FALSE);
+        g_return_val_if_fail(total_size > 0, FALSE);
+        g_return_val_if_fail(connections > 1, FALSE);
+        g_return_val_if_fail(checksum_out == NULL || *checksum_out == NULL, FALSE);
+        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+        fp = g_fopen(file, "wb+");
+        if (!fp) {
+                int err = errno;
+                g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_FAILED,
+                            "Failed to open %s for download: %s", file, g_strerror(err));
+                return FALSE;
+        }
+
+        if (!preallocate_file(fp, file, 0, total_size, error))
+                return FALSE;
+
+        // don't bother splitting small artifacts into tiny ranges
+        if ((curl_off_t) connections > total_size / (128 * 1024))
+                connections = (gint) MAX(total_size / (128 * 1024), 1);
+
+        segment_size = total_size / connections;
+        segments = g_new0(struct download_segment, connections);
+        threads = g_new0(GThread *, connections);
+
+        g_debug("Downloading %" CURL_FORMAT_CURL_OFF_T " bytes over %d connections",
+                total_size, connections);
+
+        start_time = g_get_monotonic_time();
+
+        for (i = 0; i < connections; i++) {
+                segments[i].download_url = download_url;
+                segments[i].fd = fileno(fp);
+                segments[i].offset = i * segment_size;
+                segments[i].size = (i == connections - 1) ? total_size - segments[i].offset
+                                   : segment_size;
+                threads[i] = g_thread_new("segment", download_segment_thread, &segments[i]);
+        }
+
+        for (i = 0; i < connections; i++)
+                g_thread_join(threads[i]);
+
+        // propagate the first failed segment's error, drop the others
+        for (i = 0; i < connections; i++) {
+                if (!segments[i].error)
+                        continue;
+
+                if (!segment_error)
+                        segment_error = g_steal_pointer(&segments[i].error);
+                else
+                        g_clear_error(&segments[i].error);
+        }
+
+        if (segment_error) {
+                g_propagate_error(error, segment_error);
+                return FALSE;
+        }
+
+        elapsed_usec = g_get_monotonic_time() - start_time;
+        *speed = elapsed_usec ? total_size * G_USEC_PER_SEC / elapsed_usec : 0;
+
+        // ranges finish out of order, verify with one sequential read pass
+        if (checksum_out) {
+                g_autoptr(Hash) checksum = hash_new(hash_type);
+
+                if (!checksum_file_prefix(checksum, fp, error))
+                        return FALSE;
+
+                *checksum_out = g_strdup(hash_get_string(checksum));
+        }
+
+        return TRUE;
+}
+
+size_t curl_write_cb(const void *content, size_t size, size_t nmemb, void *data)
+{
+        RestPayload *p = NULL;
+        size_t real_size = size * nmemb;
+
+        g_return_val_if_fail(content, 0);
+        g_return_val_if_fail(data, 0);
+
+        p = (RestPayload *) data;
+
+        if (p->size + real_size + 1 > p->capacity) {
+                size_t new_capacity = p->capacity ? p->capacity
+                                      : DEFAULT_CURL_REQUEST_BUFFER_SIZE;
+
+                while (new_capacity < p->size + real_size + 1)
+                        new_capacity *= 2;
+
+                p->payload = (gchar *) g_realloc(p->payload, new_capacity);
+                p->capacity = new_capacity;
+        }
+
+        // copy content to buffer
+        memcpy(&(p->payload[p->size]), content, real_size);
+        p->size += real_size;
+        p->payload[p->size] = '\0';
+
+        return real_size;
+}
+
+/**
+ * @brief Context for curl_response_header_cb().
+ */
+struct rest_header_ctx {
+        RestPayload *payload;         /**< response buffer to preallocate */
+        gchar **etag;                 /**< return location for the response's ETag or NULL */
+};
+
+/**
+ * @brief Curl callback inspecting REST response headers: preallocates the
+ *        response buffer from Content-Length so the body is received without
+ *        further reallocations and captures the ETag validator (if
+ *        requested) for conditional requests.
+ *
+ * @see   https://curl.haxx.se/libcurl/c/CURLOPT_HEADERFUNCTION.html
+ */
+static size_t curl_response_header_cb(const void *content, size_t size, size_t nmemb, void *data)
+{
+        struct rest_header_ctx *ctx = NULL;
+        RestPayload *p = NULL;
+        size_t real_size = size * nmemb;
+        g_autofree gchar *header = NULL;
+
+        g_return_val_if_fail(content, 0);
+        g_return_val_if_fail(data, 0);
 
-        g_return_val_if_reached(NULL);
+        ctx = (struct rest_header_ctx *) data;
+        p = ctx->payload;
+        header = g_strndup(content, real_size);
+
+        if (g_ascii_strncasecmp(header, "Content-Length:", 15) == 0) {
+                gint64 length = g_ascii_strtoll(header + 15, NULL, 10);
+
+                // trust sane sizes only, the write callback handles the rest
+                if (length > 0 && length < 64 * 1024 * 1024 &&
+                    (size_t) length + 1 > p->capacity) {
+                        p->payload = (gchar *) g_realloc(p->payload, length + 1);
+                        p->capacity = length + 1;
+                }
+        } else if (ctx->etag && g_ascii_strncasecmp(header, "ETag:", 5) == 0) {
+                g_free(*ctx->etag);
+                *ctx->etag = g_strstrip(g_strdup(header + 5));
+        }
+
+        return real_size;
 }
 
 /**
- * @brief Add hawkBit authorization header to Curl headers.
- *
- * @param[out] headers curl_slist** of already set headers
- * @param[out] error   Error
- * @return TRUE if authorization method set in config and header was added successfully, TRUE if no
- *         authorization method set, FALSE otherwise (error set)
+ * @brief Validators of the last fully processed response per conditionally
+ *        requested URL. Validators of a just received response are staged
+ *        first and only committed once the caller processed the response
+ *        successfully: identical server content does not mean the previous
+ *        processing (identify, deployment, cancel, feedback) succeeded, and
+ *        skipping based on an unprocessed response would wedge the client
+ *        until the server content changes.
  */
-static gboolean set_auth_curl_header(struct curl_slist **headers, GError **error)
-{
-        gboolean res = TRUE;
-        g_autofree gchar *token = NULL;
+struct conditional_cache_entry {
+        gchar *etag;                  /**< ETag of the last processed response or NULL */
+        gchar *digest;                /**< content digest of the last processed response */
+        gchar *pending_etag;          /**< staged ETag of the response being processed */
+        gchar *pending_digest;        /**< staged digest of the response being processed */
+};
 
-        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+static GHashTable *conditional_cache = NULL;
+static GMutex conditional_cache_mutex;
 
-        token = get_auth_header();
-        if (token)
-                res = add_curl_header(headers, token, error);
+static void conditional_cache_entry_free(gpointer data)
+{
+        struct conditional_cache_entry *entry = data;
 
-        return res;
+        g_free(entry->etag);
+        g_free(entry->digest);
+        g_free(entry->pending_etag);
+        g_free(entry->pending_digest);
+        g_free(entry);
 }
 
 /**
- * @brief Set common Curl options, namely user agent, connect timeout, SSL
- *        verify peer and SSL verify host options.
+ * @brief Get the cached ETag for url, to be sent as If-None-Match.
  *
- * @param[in] curl Curl handle
+ * @param[in] url URL the ETag was cached for
+ * @return Newly allocated ETag string or NULL if none cached
  */
-static void set_default_curl_opts(CURL *curl)
+static gchar* conditional_cache_get_etag(const gchar *url)
 {
-        g_return_if_fail(curl);
+        struct conditional_cache_entry *entry = NULL;
+        gchar *etag = NULL;
 
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, HAWKBIT_USERAGENT);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, hawkbit_config->connect_timeout);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, hawkbit_config->ssl_verify ? 1L : 0L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, hawkbit_config->ssl_verify ? 1L : 0L);
+        g_mutex_lock(&conditional_cache_mutex);
+        if (conditional_cache)
+                entry = g_hash_table_lookup(conditional_cache, url);
+        if (entry)
+                etag = g_strdup(entry->etag);
+        g_mutex_unlock(&conditional_cache_mutex);
+
+        return etag;
 }
 
 /**
- * @brief Download download_url to file.
+ * @brief Check whether the response content is identical to the last fully
+ *        processed one (digest short-circuit for servers not emitting ETags)
+ *        and, if not, stage its validators for conditional_cache_commit().
  *
- * @param[in]  download_url URL to download from
- * @param[in]  file         Download destination
- * @param[in]  resume_from  Offset to resume download from
- * @param[out] sha1sum      Calculated checksum or NULL
- * @param[out] speed        Average download speed
- * @param[out] error        Error
- * @return TRUE if download succeeded, FALSE otherwise (error set)
+ * @param[in] url    Requested URL
+ * @param[in] etag   ETag of the response or NULL
+ * @param[in] digest Content digest of the response
+ * @return TRUE if the content digest matches the last processed response,
+ *         FALSE otherwise (validators staged)
  */
-static gboolean get_binary(const gchar *download_url, const gchar *file, curl_off_t resume_from,
-                           gchar **sha1sum, curl_off_t *speed, GError **error)
+static gboolean conditional_cache_check_and_stage(const gchar *url, const gchar *etag,
+                                                  const gchar *digest)
 {
-        g_autoptr(CURL) curl = NULL;
-        g_autoptr(FILE) fp = NULL;
-        CURLcode curl_code;
-        glong http_code = 0;
-        struct curl_slist *headers = NULL;
+        struct conditional_cache_entry *entry = NULL;
+        gboolean unchanged;
 
-        g_return_val_if_fail(download_url, FALSE);
-        g_return_val_if_fail(file, FALSE);
-        g_return_val_if_fail(sha1sum == NULL || *sha1sum == NULL, FALSE);
-        g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+        g_mutex_lock(&conditional_cache_mutex);
 
-        if (resume_from)
-                g_debug("Resuming download from offset %" CURL_FORMAT_CURL_OFF_T, resume_from);
+        if (!conditional_cache)
+                conditional_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                                          conditional_cache_entry_free);
 
-        fp = g_fopen(file, (resume_from) ? "ab+" : "wb+");
-        if (!fp) {
-                int err = errno;
-                g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_FAILED,
-                            "Failed to open %s for download: %s", file, g_strerror(err));
-                return FALSE;
+        entry = g_hash_table_lookup(conditional_cache, url);
+        if (!entry) {
+                entry = g_new0(struct conditional_cache_entry, 1);
+                g_hash_table_insert(conditional_cache, g_strdup(url), entry);
         }
 
-        curl = curl_easy_init();
-        if (!curl) {
-                g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, CURLE_FAILED_INIT,
-                            "Unable to start libcurl easy session");
-                return FALSE;
+        unchanged = entry->digest && !g_strcmp0(entry->digest, digest);
+
+        if (!unchanged) {
+                g_free(entry->pending_etag);
+                entry->pending_etag = g_strdup(etag);
+                g_free(entry->pending_digest);
+                entry->pending_digest = g_strdup(digest);
         }
 
-        set_default_curl_opts(curl);
-        curl_easy_setopt(curl, CURLOPT_URL, download_url);
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 8L);
-        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+        g_mutex_unlock(&conditional_cache_mutex);
 
-        // abort if slower than configured download rate during configured time span
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, hawkbit_config->low_speed_time);
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, hawkbit_config->low_speed_rate);
+        return unchanged;
+}
 
-        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, resume_from);
+/**
+ * @brief Promote the staged validators for url, to be called once the
+ *        response was processed successfully. Subsequent identical responses
+ *        may then be skipped.
+ *
+ * @param[in] url Requested URL
+ */
+static void conditional_cache_commit(const gchar *url)
+{
+        struct conditional_cache_entry *entry = NULL;
 
-        if (!set_auth_curl_header(&headers, error))
-                return FALSE;
+        g_mutex_lock(&conditional_cache_mutex);
 
-        // set up request headers
-        if (!add_curl_header(&headers, "Accept: application/octet-stream", error))
-                return FALSE;
+        if (conditional_cache)
+                entry = g_hash_table_lookup(conditional_cache, url);
 
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        if (entry && entry->pending_digest) {
+                g_free(entry->etag);
+                entry->etag = g_steal_pointer(&entry->pending_etag);
+                g_free(entry->digest);
+                entry->digest = g_steal_pointer(&entry->pending_digest);
+        }
 
-        // perform transfer
-        curl_code = curl_easy_perform(curl);
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-        curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD_T, speed);
-        curl_slist_free_all(headers);
+        g_mutex_unlock(&conditional_cache_mutex);
+}
 
-        if (curl_code != CURLE_OK) {
-                g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, curl_code, "%s",
-                            curl_easy_strerror(curl_code));
-                return FALSE;
-        }
-        // consider ok/partial download/range not satisfiable (EOF reached) as success
-        if (http_code != 200 && http_code != 206 && http_code != 416) {
-                g_set_error(error, RHU_HAWKBIT_CLIENT_HTTP_ERROR, http_code,
-                            "HTTP request failed: %ld", http_code);
-                return FALSE;
-        }
+/**
+ * @brief Drop all cached validators, forcing full processing of the next
+ *        poll. Required whenever an action closes locally: the server may
+ *        keep serving identical content (e.g. because our closing feedback
+ *        did not arrive) that must not be skipped.
+ */
+static void conditional_cache_clear(void)
+{
+        g_mutex_lock(&conditional_cache_mutex);
 
-        // if checksum enabled then return the value
-        if (sha1sum && !get_file_checksum(fp, G_CHECKSUM_SHA1, sha1sum, error))
-                return FALSE;
+        if (conditional_cache)
+                g_hash_table_remove_all(conditional_cache);
 
-        return TRUE;
+        g_mutex_unlock(&conditional_cache_mutex);
 }
 
 /**
- * @brief Curl callback writing REST response to RestPayload*->payload buffer.
+ * @brief Gzip-compress a memory buffer.
  *
- * @see   https://curl.haxx.se/libcurl/c/CURLOPT_WRITEFUNCTION.html
+ * @param[in]  data            Data to compress
+ * @param[in]  size            Size of data in bytes
+ * @param[out] compressed_size Size of the compressed result in bytes
+ * @return Newly allocated compressed data (must be freed), NULL on error
  */
-static size_t curl_write_cb(const void *content, size_t size, size_t nmemb, void *data)
+static gchar* gzip_compress(const gchar *data, gsize size, gsize *compressed_size)
 {
-        RestPayload *p = NULL;
-        size_t real_size = size * nmemb;
+        g_autoptr(GZlibCompressor) compressor = NULL;
+        g_autoptr(GOutputStream) out = NULL, converter = NULL;
 
-        g_return_val_if_fail(content, 0);
-        g_return_val_if_fail(data, 0);
+        g_return_val_if_fail(data, NULL);
+        g_return_val_if_fail(compressed_size, NULL);
 
-        p = (RestPayload *) data;
-        p->payload = (gchar *) g_realloc(p->payload, p->size + real_size + 1);
+        compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+        out = g_memory_output_stream_new_resizable();
+        converter = g_converter_output_stream_new(out, G_CONVERTER(compressor));
 
-        // copy content to buffer
-        memcpy(&(p->payload[p->size]), content, real_size);
-        p->size += real_size;
-        p->payload[p->size] = '\0';
+        if (!g_output_stream_write_all(converter, data, size, NULL, NULL, NULL) ||
+            !g_output_stream_close(converter, NULL, NULL))
+                return NULL;
 
-        return real_size;
+        *compressed_size = g_memory_output_stream_get_data_size(
+                G_MEMORY_OUTPUT_STREAM(out));
+
+        return g_memory_output_stream_steal_data(G_MEMORY_OUTPUT_STREAM(out));
 }
 
 /**
@@ -380,15 +1603,23 @@ static size_t curl_write_cb(const void *content, size_t size, size_t nmemb, void
  * @param[in]  jsonRequestBody    REST request body. If NULL, no body is sent
  * @param[out] jsonResponseParser Return location for a REST response or NULL to skip response
  *                                parsing
+ * @param[out] retry_after_sec    Return location for the server's Retry-After header value in
+ *                                seconds (0 if not sent) or NULL to ignore it
+ * @param[out] unmodified         Return location for whether the response was unchanged since
+ *                                the previous request of this URL (via ETag/If-None-Match or
+ *                                content digest) or NULL to request unconditionally
  * @param[out] error              Error
  * @return TRUE if request and response parser (if given) suceeded, FALSE otherwise (error set).
+ *         Note that with unmodified set to TRUE, no response parser is returned.
  */
-static gboolean rest_request(enum HTTPMethod method, const gchar *url,
-                             JsonBuilder *jsonRequestBody, JsonParser **jsonResponseParser,
-                             GError **error)
+gboolean rest_request(enum HTTPMethod method, const gchar *url,
+                      JsonBuilder *jsonRequestBody, JsonParser **jsonResponseParser,
+                      glong *retry_after_sec, gboolean *unmodified, GError **error)
 {
-        g_autofree gchar *postdata = NULL;
+        g_autofree gchar *postdata = NULL, *compressed_postdata = NULL;
+        g_autofree gchar *response_etag = NULL;
         g_autoptr(RestPayload) fetch_buffer = NULL;
+        struct rest_header_ctx header_ctx = {NULL, NULL};
         struct curl_slist *headers = NULL;
         g_autoptr(CURL) curl = NULL;
         glong http_code = 0;
@@ -398,17 +1629,21 @@ static gboolean rest_request(enum HTTPMethod method, const gchar *url,
         g_return_val_if_fail(jsonResponseParser == NULL || *jsonResponseParser == NULL, FALSE);
         g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-        curl = curl_easy_init();
-        if (!curl) {
-                g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, CURLE_FAILED_INIT,
-                            "Unable to start libcurl easy session");
+        curl = acquire_curl_handle(error);
+        if (!curl)
                 return FALSE;
-        }
 
         // init response buffer
         fetch_buffer = g_new0(RestPayload, 1);
         fetch_buffer->size = 0;
-        fetch_buffer->payload = g_malloc0(DEFAULT_CURL_REQUEST_BUFFER_SIZE);
+        fetch_buffer->capacity = DEFAULT_CURL_REQUEST_BUFFER_SIZE;
+        fetch_buffer->payload = g_malloc0(fetch_buffer->capacity);
+
+        header_ctx.payload = fetch_buffer;
+        if (unmodified) {
+                *unmodified = FALSE;
+                header_ctx.etag = &response_etag;
+        }
 
         // set up CURL options
         set_default_curl_opts(curl);
@@ -417,15 +1652,34 @@ static gboolean rest_request(enum HTTPMethod method, const gchar *url,
         curl_easy_setopt(curl, CURLOPT_TIMEOUT, hawkbit_config->timeout);
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_write_cb);
         curl_easy_setopt(curl, CURLOPT_WRITEDATA, fetch_buffer);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curl_response_header_cb);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &header_ctx);
+
+        // negotiate compressed responses, curl decodes transparently
+        if (hawkbit_config->compress_responses)
+                curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
 
         if (jsonRequestBody) {
                 g_autoptr(JsonGenerator) generator = json_generator_new();
                 g_autoptr(JsonNode) req_root = json_builder_get_root(jsonRequestBody);
                 g_autofree gchar *json_req_str = NULL;
+                gsize compressed_size = 0;
 
                 json_generator_set_root(generator, req_root);
                 postdata = json_generator_to_data(generator, NULL);
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postdata);
+
+                // compress large request bodies (e.g. the configData PUT)
+                if (hawkbit_config->compress_requests && strlen(postdata) > 1024)
+                        compressed_postdata = gzip_compress(postdata, strlen(postdata),
+                                                            &compressed_size);
+
+                if (compressed_postdata) {
+                        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, compressed_postdata);
+                        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (glong) compressed_size);
+                } else {
+                        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postdata);
+                }
+
                 json_req_str = json_to_string(req_root, TRUE);
                 g_debug("Request body: %s", json_req_str);
         }
@@ -441,17 +1695,55 @@ static gboolean rest_request(enum HTTPMethod method, const gchar *url,
             !add_curl_header(&headers, "Content-Type: application/json;charset=UTF-8", error))
                 return FALSE;
 
+        if (compressed_postdata &&
+            !add_curl_header(&headers, "Content-Encoding: gzip", error))
+                return FALSE;
+
+        // ask the server to answer 304 without a body if nothing changed
+        if (unmodified) {
+                g_autofree gchar *cached_etag = conditional_cache_get_etag(url);
+
+                if (cached_etag) {
+                        g_autofree gchar *if_none_match =
+                                g_strdup_printf("If-None-Match: %s", cached_etag);
+
+                        if (!add_curl_header(&headers, if_none_match, error))
+                                return FALSE;
+                }
+        }
+
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
         // perform request
-        res = curl_easy_perform(curl);
+        res = perform_curl_transfer(curl);
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        metrics_record_transfer(curl, FALSE);
         curl_slist_free_all(headers);
+
+        if (retry_after_sec) {
+                *retry_after_sec = 0;
+#if CURL_AT_LEAST_VERSION(7, 66, 0)
+                {
+                        curl_off_t retry_after = 0;
+
+                        if (curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retry_after) == CURLE_OK)
+                                *retry_after_sec = (glong) retry_after;
+                }
+#endif
+        }
+
         if (res != CURLE_OK) {
                 g_set_error(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, res, "%s",
                             curl_easy_strerror(res));
                 return FALSE;
         }
+
+        if (unmodified && http_code == 304) {
+                g_debug("Not modified (304): %s", url);
+                *unmodified = TRUE;
+                return TRUE;
+        }
+
         if (http_code != 200) {
                 g_set_error(error, RHU_HAWKBIT_CLIENT_HTTP_ERROR, http_code,
                             "HTTP request failed: %ld; server response: %s", http_code,
@@ -459,6 +1751,22 @@ static gboolean rest_request(enum HTTPMethod method, const gchar *url,
                 return FALSE;
         }
 
+        // digest short-circuit for servers not emitting ETags; changed
+        // validators are staged and committed by the caller after processing
+        if (unmodified) {
+                g_autoptr(Hash) hash = hash_new(HASH_TYPE_SHA256);
+                g_autofree gchar *digest = NULL;
+
+                hash_update(hash, (const guchar *) fetch_buffer->payload, fetch_buffer->size);
+                digest = g_strdup(hash_get_string(hash));
+
+                if (conditional_cache_check_and_stage(url, response_etag, digest)) {
+                        g_debug("Response content unchanged: %s", url);
+                        *unmodified = TRUE;
+                        return TRUE;
+                }
+        }
+
         if (jsonResponseParser && fetch_buffer->size > 0) {
                 // process JSON repsonse
                 g_autoptr(JsonParser) parser = json_parser_new_immutable();
@@ -478,9 +1786,54 @@ static gboolean rest_request(enum HTTPMethod method, const gchar *url,
         return TRUE;
 }
 
+/**
+ * @brief Callback flagging an elapsed retry backoff period.
+ *
+ * @param[in] user_data gboolean* set to TRUE
+ * @return G_SOURCE_REMOVE is always returned
+ */
+static gboolean backoff_elapsed_cb(gpointer user_data)
+{
+        *(gboolean *) user_data = TRUE;
+
+        return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Wait usec microseconds before retrying a request. On the thread
+ *        running the client's main context, pending sources keep being
+ *        dispatched while waiting, so the main loop is never blocked during
+ *        backoff. Paths that must sleep instead (worker threads, or the main
+ *        thread while holding active_action->mutex) are capped at the
+ *        historical 1 s pacing, so a 409/429 burst cannot stall the main
+ *        loop or the watchdog for the full exponential backoff.
+ *
+ * @param[in] usec Microseconds to wait
+ */
+static void retry_backoff_wait(gint64 usec)
+{
+        gboolean elapsed = FALSE;
+        g_autoptr(GSource) timeout_source = NULL;
+
+        if (!context_dispatch_allowed || !client_context ||
+            !g_main_context_is_owner(client_context)) {
+                g_usleep(MIN(usec, G_USEC_PER_SEC));
+                return;
+        }
+
+        timeout_source = g_timeout_source_new((guint) (usec / 1000));
+        g_source_set_name(timeout_source, "hawkBit retry backoff");
+        g_source_set_callback(timeout_source, backoff_elapsed_cb, &elapsed, NULL);
+        g_source_attach(timeout_source, client_context);
+
+        while (!elapsed)
+                g_main_context_iteration(client_context, TRUE);
+}
+
 /**
  * @brief Perform REST request with JSON data, expecting response JSON data. On HTTP error
- * 409 (Conflict) and 429 (Too Many Requests), try again (up to MAX_RETRIES_ON_API_ERROR).
+ * 409 (Conflict) and 429 (Too Many Requests), try again (up to MAX_RETRIES_ON_API_ERROR)
+ * with exponential backoff and jitter, honoring the server's Retry-After header if sent.
  *
  * @param[in]  method             HTTP Method, e.g. GET
  * @param[in]  url                URL used in HTTP REST request
@@ -496,6 +1849,7 @@ static gboolean rest_request_retriable(enum HTTPMethod method, const gchar *url,
 {
         gboolean res, retry;
         gint retry_count = 0;
+        glong retry_after_sec = 0;
         GError *ierror = NULL;
 
         g_return_val_if_fail(url, FALSE);
@@ -503,17 +1857,31 @@ static gboolean rest_request_retriable(enum HTTPMethod method, const gchar *url,
         g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
         while (1) {
-                res = rest_request(method, url, jsonRequestBody, jsonResponseParser, &ierror);
+                gint64 wait_usec;
+
+                res = rest_request(method, url, jsonRequestBody, jsonResponseParser,
+                                   &retry_after_sec, NULL, &ierror);
                 retry = (g_error_matches(ierror, RHU_HAWKBIT_CLIENT_HTTP_ERROR, 409) ||
                          g_error_matches(ierror, RHU_HAWKBIT_CLIENT_HTTP_ERROR, 429)) &&
                         retry_count < MAX_RETRIES_ON_API_ERROR;
                 if (!retry)
                         break;
 
-                g_debug("%s Trying again (%d/%d)..", ierror->message, retry_count+1,
+                if (retry_after_sec > 0) {
+                        wait_usec = (gint64) retry_after_sec * G_USEC_PER_SEC;
+                } else {
+                        // exponential backoff (1, 2, 4, .. 60 s), randomized to 50-100%
+                        gint64 backoff_usec = MIN(1L << MIN(retry_count, 6), 60L) *
+                                              G_USEC_PER_SEC;
+                        wait_usec = backoff_usec / 2 +
+                                    g_random_int_range(0, (gint32) (backoff_usec / 2));
+                }
+
+                g_debug("%s Trying again in %.1f s (%d/%d)..", ierror->message,
+                        (double) wait_usec / G_USEC_PER_SEC, retry_count+1,
                         MAX_RETRIES_ON_API_ERROR);
                 g_clear_error(&ierror);
-                g_usleep(1000000);
+                retry_backoff_wait(wait_usec);
                 retry_count++;
         }
 
@@ -529,13 +1897,13 @@ static gboolean rest_request_retriable(enum HTTPMethod method, const gchar *url,
  * @see https://eclipse.dev/hawkbit/rest-api/rootcontroller-api-guide.html#_post_tenantcontrollerv1controlleriddeploymentbaseactionidfeedback
  *
  * @param[in] id         hawkBit action ID or NULL (configData usecase)
- * @param[in] detail     Detail message or NULL (configData usecase)
+ * @param[in] details    GPtrArray* of detail messages (gchar*) or NULL (configData usecase)
  * @param[in] finished   hawkBit status of the result
  * @param[in] execution  hawkBit status of the action execution
  * @param[in] attributes hawkBit controller attributes or NULL (feedback usecase)
  * @return JsonBuilder* with built hawkBit request
  */
-static JsonBuilder* json_build_status(const gchar *id, const gchar *detail, const gchar *finished,
+static JsonBuilder* json_build_status(const gchar *id, GPtrArray *details, const gchar *finished,
                                       const gchar *execution, GHashTable *attributes)
 {
         GHashTableIter iter;
@@ -578,10 +1946,13 @@ static JsonBuilder* json_build_status(const gchar *id, const gchar *detail, cons
         json_builder_set_member_name(builder, "execution");
         json_builder_add_string_value(builder, execution);
 
-        if (detail) {
+        if (details && details->len) {
+                guint i;
+
                 json_builder_set_member_name(builder, "details");
                 json_builder_begin_array(builder);
-                json_builder_add_string_value(builder, detail);
+                for (i = 0; i < details->len; i++)
+                        json_builder_add_string_value(builder, g_ptr_array_index(details, i));
                 json_builder_end_array(builder);
         }
         json_builder_end_object(builder);
@@ -616,6 +1987,7 @@ static gboolean feedback(const gchar *url, const gchar *id, const gchar *detail,
                          const gchar *finished, const gchar *execution, GError **error)
 {
         g_autoptr(JsonBuilder) builder = NULL;
+        g_autoptr(GPtrArray) details = NULL;
         gboolean res = FALSE;
 
         g_return_val_if_fail(url, FALSE);
@@ -630,7 +2002,9 @@ static gboolean feedback(const gchar *url, const gchar *id, const gchar *detail,
         else
                 g_message("%s", detail);
 
-        builder = json_build_status(id, detail, finished, execution, NULL);
+        details = g_ptr_array_new();
+        g_ptr_array_add(details, (gpointer) detail);
+        builder = json_build_status(id, details, finished, execution, NULL);
 
         res = rest_request_retriable(POST, url, builder, NULL, error);
         if (!res)
@@ -679,11 +2053,15 @@ static long json_get_sleeptime(JsonNode *root)
         g_return_val_if_fail(root, 0L);
 
         /* When processing an action, return fixed sleeptime of 5s to allow
-         * receiving cancelation requests etc.*/
+         * receiving cancelation requests etc. During streaming installations
+         * this also covers ACTION_STATE_INSTALLING: those polls are cheap
+         * cancel-only checks (conditional request, no link processing). */
         g_mutex_lock(&active_action->mutex);
         if (active_action->state == ACTION_STATE_PROCESSING ||
             active_action->state == ACTION_STATE_DOWNLOADING ||
-            active_action->state == ACTION_STATE_CANCEL_REQUESTED) {
+            active_action->state == ACTION_STATE_CANCEL_REQUESTED ||
+            (hawkbit_config->stream_bundle &&
+             active_action->state == ACTION_STATE_INSTALLING)) {
                 g_mutex_unlock(&active_action->mutex);
                 return 5L;
         }
@@ -696,95 +2074,353 @@ static long json_get_sleeptime(JsonNode *root)
                 return hawkbit_config->retry_wait;
         }
 
-        strptime(sleeptime_str, "%T", &time);
-        return (time.tm_sec + (time.tm_min * 60) + (time.tm_hour * 60 * 60));
+        strptime(sleeptime_str, "%T", &time);
+        return (time.tm_sec + (time.tm_min * 60) + (time.tm_hour * 60 * 60));
+}
+
+/**
+ * @brief Build API URL
+ *
+ * @param path[in] a printf()-like format string describing the API path or NULL for base path
+ * @param ... The arguments to be inserted in path
+ *
+ * @return a newly allocated full API URL
+ */
+__attribute__((__format__(__printf__, 1, 2)))
+static gchar* build_api_url(const gchar *path, ...)
+{
+        g_autofree gchar *buffer = NULL;
+        va_list args;
+
+        if (path) {
+                va_start(args, path);
+                buffer = g_strdup_vprintf(path, args);
+                va_end(args);
+        }
+
+        return g_strdup_printf(
+                "%s://%s/%s/controller/v1/%s%s%s",
+                hawkbit_config->ssl ? "https" : "http",
+                hawkbit_config->hawkbit_server, hawkbit_config->tenant_id,
+                hawkbit_config->controller_id,
+                buffer ? "/" : "",
+                buffer ? buffer : "");
+}
+
+/**
+ * @brief Check whether msg is a percentage progress message as formatted by
+ *        the installer client ("%3d%% ..."). Such messages supersede each
+ *        other, only the latest one queued needs to be reported.
+ *
+ * @param[in] msg Progress message
+ * @return TRUE if msg is a percentage progress message, FALSE otherwise
+ */
+static gboolean is_percentage_progress(const gchar *msg)
+{
+        return strlen(msg) >= 4 && msg[3] == '%' && g_ascii_isdigit(msg[2]);
+}
+
+/**
+ * @brief Send all queued progress messages as a single feedback request
+ *        (finished=none, execution=proceeding) with one details entry per
+ *        message. Must be called under locked active_action->mutex.
+ */
+static void flush_progress_feedback_locked(void)
+{
+        g_autoptr(GPtrArray) details = NULL;
+        g_autofree gchar *feedback_url = NULL;
+        g_autoptr(JsonBuilder) builder = NULL;
+        g_autoptr(GError) error = NULL;
+
+        g_mutex_lock(&progress_queue_mutex);
+        progress_flush_pending = FALSE;
+        if (progress_queue && progress_queue->len) {
+                details = g_steal_pointer(&progress_queue);
+                progress_queue = g_ptr_array_new_with_free_func(g_free);
+        }
+        g_mutex_unlock(&progress_queue_mutex);
+
+        // nothing queued or action gone already
+        if (!details || !active_action->id)
+                return;
+
+        feedback_url = build_api_url("deploymentBase/%s/feedback", active_action->id);
+        builder = json_build_status(active_action->id, details, "none", "proceeding", NULL);
+
+        if (!rest_request_retriable(POST, feedback_url, builder, NULL, &error))
+                g_warning("Progress feedback: Failed to report progress: %s", error->message);
+}
+
+/**
+ * @brief Callback for the progress feedback sender, flushes the queued
+ *        progress messages in one feedback request.
+ *
+ * @param[in] user_data Not used
+ * @return G_SOURCE_REMOVE is always returned
+ */
+static gboolean progress_feedback_flush_cb(gpointer user_data)
+{
+        gboolean dispatch_was_allowed = FALSE;
+        gboolean on_client_thread = client_context &&
+                                    g_main_context_is_owner(client_context);
+
+        // the flush locks active_action->mutex, its own transfers must not
+        // dispatch sources doing the same; on other threads (direct
+        // single-shot flush) the flag is not ours to touch and transfers
+        // never dispatch there anyway
+        if (on_client_thread) {
+                dispatch_was_allowed = context_dispatch_allowed;
+                context_dispatch_allowed = FALSE;
+        }
+
+        g_mutex_lock(&active_action->mutex);
+        flush_progress_feedback_locked();
+        g_mutex_unlock(&active_action->mutex);
+
+        if (on_client_thread)
+                context_dispatch_allowed = dispatch_was_allowed;
+
+        return G_SOURCE_REMOVE;
+}
+
+gboolean hawkbit_progress(const gchar *msg)
+{
+        g_autofree gchar *annotated = NULL;
+
+        g_return_val_if_fail(msg, FALSE);
+
+        g_mutex_lock(&progress_queue_mutex);
+
+        // derive stream throughput from percentage progress and artifact size
+        if (stream_install_size > 0 && is_percentage_progress(msg)) {
+                gint64 percent = g_ascii_strtoll(msg, NULL, 10);
+                gint64 elapsed = g_get_monotonic_time() - stream_install_started_at;
+
+                if (percent > 0 && elapsed > 0)
+                        annotated = g_strdup_printf(
+                                "%s (stream avg %.2f MB/s)", msg,
+                                (double) stream_install_size * percent / 100 /
+                                (1024 * 1024) * G_USEC_PER_SEC / elapsed);
+        }
+
+        // replace a queued, not yet sent percentage message with the newer one
+        if (progress_queue->len && is_percentage_progress(msg) &&
+            is_percentage_progress(g_ptr_array_index(progress_queue, progress_queue->len - 1)))
+                g_ptr_array_remove_index(progress_queue, progress_queue->len - 1);
+
+        g_ptr_array_add(progress_queue,
+                        annotated ? g_steal_pointer(&annotated) : g_strdup(msg));
+
+        // arm the sender, coalescing further messages until it fires
+        if (client_context && !progress_flush_pending) {
+                g_autoptr(GSource) flush_source =
+                        g_timeout_source_new_seconds(hawkbit_config->progress_interval);
+
+                g_source_set_name(flush_source, "hawkBit progress feedback");
+                g_source_set_callback(flush_source, progress_feedback_flush_cb, NULL, NULL);
+                g_source_attach(flush_source, client_context);
+                progress_flush_pending = TRUE;
+        }
+
+        g_mutex_unlock(&progress_queue_mutex);
+
+        // without a main loop (single-shot direct path) flush right away
+        if (!client_context)
+                progress_feedback_flush_cb(NULL);
+
+        return G_SOURCE_REMOVE;
 }
 
+static gchar *config_data_digest = NULL;
+static gint64 config_data_uploaded_at = 0;
+static gboolean config_data_upload_skipped = FALSE;
+
 /**
- * @brief Build API URL
+ * @brief Build path of the configData digest cache file, stored next to the
+ *        bundle download location.
  *
- * @param path[in] a printf()-like format string describing the API path or NULL for base path
- * @param ... The arguments to be inserted in path
+ * @return Newly allocated path, NULL if no bundle_download_location is
+ *         configured (digest is then only cached in memory)
+ */
+static gchar* config_data_digest_path(void)
+{
+        if (!hawkbit_config->bundle_download_location)
+                return NULL;
+
+        return g_strdup_printf("%s.configdata", hawkbit_config->bundle_download_location);
+}
+
+/**
+ * @brief Calculate digest over the device attributes (sorted by key, so hash
+ *        table iteration order does not matter), to detect changes between
+ *        identify() calls.
  *
- * @return a newly allocated full API URL
+ * @return Newly allocated digest hex string
  */
-__attribute__((__format__(__printf__, 1, 2)))
-static gchar* build_api_url(const gchar *path, ...)
+static gchar* calculate_config_data_digest(void)
 {
-        g_autofree gchar *buffer = NULL;
-        va_list args;
+        g_autoptr(Hash) hash = hash_new(HASH_TYPE_SHA256);
+        g_autoptr(GList) keys = g_hash_table_get_keys(hawkbit_config->device);
+        GList *l;
 
-        if (path) {
-                va_start(args, path);
-                buffer = g_strdup_vprintf(path, args);
-                va_end(args);
+        keys = g_list_sort(keys, (GCompareFunc) g_strcmp0);
+
+        for (l = keys; l; l = l->next) {
+                const gchar *key = l->data;
+                const gchar *value = g_hash_table_lookup(hawkbit_config->device, key);
+
+                hash_update(hash, (const guchar *) key, strlen(key));
+                hash_update(hash, (const guchar *) "=", 1);
+                hash_update(hash, (const guchar *) value, strlen(value));
+                hash_update(hash, (const guchar *) "\n", 1);
         }
 
-        return g_strdup_printf(
-                "%s://%s/%s/controller/v1/%s%s%s",
-                hawkbit_config->ssl ? "https" : "http",
-                hawkbit_config->hawkbit_server, hawkbit_config->tenant_id,
-                hawkbit_config->controller_id,
-                buffer ? "/" : "",
-                buffer ? buffer : "");
+        return g_strdup(hash_get_string(hash));
 }
 
-gboolean hawkbit_progress(const gchar *msg)
+/**
+ * @brief Load the digest of the last successfully uploaded configData from
+ *        the cache file, so redundant uploads are skipped across restarts.
+ */
+static void config_data_digest_load(void)
 {
-        g_autofree gchar *feedback_url = NULL;
-        g_autoptr(GError) error = NULL;
+        g_autofree gchar *path = config_data_digest_path();
+        g_autoptr(GKeyFile) key_file = NULL;
 
-        g_return_val_if_fail(msg, FALSE);
+        if (!path || !g_file_test(path, G_FILE_TEST_IS_REGULAR))
+                return;
 
-        g_mutex_lock(&active_action->mutex);
+        key_file = g_key_file_new();
+        if (!g_key_file_load_from_file(key_file, path, G_KEY_FILE_NONE, NULL))
+                return;
 
-        feedback_url = build_api_url("deploymentBase/%s/feedback", active_action->id);
+        config_data_digest = g_key_file_get_string(key_file, "configData", "digest", NULL);
+        config_data_uploaded_at = g_key_file_get_int64(key_file, "configData", "uploaded", NULL);
+        config_data_upload_skipped = g_key_file_get_boolean(key_file, "configData", "skipped",
+                                                            NULL);
+}
 
-        if (!feedback_progress(feedback_url, active_action->id, msg, &error))
-                g_warning("%s", error->message);
+/**
+ * @brief Persist the digest of the just uploaded configData.
+ *
+ * @param[in] digest Uploaded attribute set's digest
+ */
+static void config_data_digest_save(const gchar *digest)
+{
+        g_autofree gchar *path = config_data_digest_path();
+        g_autofree gchar *data = NULL;
+        g_autoptr(GKeyFile) key_file = NULL;
+        gsize length = 0;
 
-        g_mutex_unlock(&active_action->mutex);
+        if (!path)
+                return;
 
-        return G_SOURCE_REMOVE;
+        key_file = g_key_file_new();
+        g_key_file_set_string(key_file, "configData", "digest", digest);
+        g_key_file_set_int64(key_file, "configData", "uploaded", config_data_uploaded_at);
+        g_key_file_set_boolean(key_file, "configData", "skipped", config_data_upload_skipped);
+
+        data = g_key_file_to_data(key_file, &length, NULL);
+        if (!g_file_set_contents(path, data, length, NULL))
+                g_debug("Failed to write configData digest cache %s", path);
 }
 
 /**
  * @brief Provide meta information that will allow the hawkBit to identify the device on a hardware
- * level.
+ * level. Unchanged attribute sets are normally answered from the digest
+ * cache, but if hawkBit still requests attributes on the next occasion (it
+ * drops the configData link once it received them), the upload is forced:
+ * a persisting request means the server lost or explicitly re-requested the
+ * attributes.
  *
  * @see https://eclipse.dev/hawkbit/rest-api/rootcontroller-api-guide.html#_put_tenantcontrollerv1controlleridconfigdata
  *
- * @param[out] error Error
+ * @param[out] uploaded Return location for whether the attributes were
+ *                      actually uploaded (FALSE on a skipped upload) or NULL
+ * @param[out] error    Error
  * @return TRUE if identification succeeded, FALSE otherwise (error set)
  */
-static gboolean identify(GError **error)
+static gboolean identify(gboolean *uploaded, GError **error)
 {
         g_autofree gchar *put_config_data_url = NULL;
+        g_autofree gchar *digest = NULL;
         g_autoptr(JsonBuilder) builder = NULL;
+        gint64 now;
 
         g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
+        if (uploaded)
+                *uploaded = FALSE;
+
+        // advertise delta capability, so rollouts can offer casync artifacts
+        if (hawkbit_config->prefer_delta && hawkbit_config->device &&
+            !g_hash_table_contains(hawkbit_config->device, "delta"))
+                g_hash_table_insert(hawkbit_config->device, g_strdup("delta"),
+                                    g_strdup("casync"));
+
+        if (!config_data_digest)
+                config_data_digest_load();
+
+        // skip serialization and upload if the attribute set did not change,
+        // unless the previous request was already answered from the cache
+        digest = calculate_config_data_digest();
+        now = g_get_real_time() / G_USEC_PER_SEC;
+        if (!g_strcmp0(digest, config_data_digest) && !config_data_upload_skipped &&
+            (!hawkbit_config->identify_interval ||
+             now - config_data_uploaded_at < hawkbit_config->identify_interval)) {
+                g_debug("Device attributes unchanged, skipping upload to hawkbit server");
+                config_data_upload_skipped = TRUE;
+                // remember the skip across restarts (single-shot invocations)
+                config_data_digest_save(digest);
+                return TRUE;
+        }
+
         g_debug("Providing meta information to hawkbit server");
         put_config_data_url = build_api_url("configData");
 
         builder = json_build_status(NULL, NULL, "success", "closed", hawkbit_config->device);
 
-        return rest_request_retriable(PUT, put_config_data_url, builder, NULL, error);
+        if (!rest_request_retriable(PUT, put_config_data_url, builder, NULL, error))
+                return FALSE;
+
+        g_free(config_data_digest);
+        config_data_digest = g_strdup(digest);
+        config_data_uploaded_at = now;
+        config_data_upload_skipped = FALSE;
+        config_data_digest_save(digest);
+
+        if (uploaded)
+                *uploaded = TRUE;
+
+        return TRUE;
 }
 
 /**
- * @brief Deletes RAUC bundle at config's bundle_download_location (if given).
+ * @brief Deletes RAUC bundle(s) at config's bundle_download_location (if
+ *        given), including the numbered files of multi-artifact deployments.
  */
 static void process_deployment_cleanup()
 {
-        if (!hawkbit_config->bundle_download_location)
-                return;
+        guint i;
 
-        if (!g_file_test(hawkbit_config->bundle_download_location, G_FILE_TEST_IS_REGULAR))
+        if (!hawkbit_config->bundle_download_location)
                 return;
 
-        if (g_remove(hawkbit_config->bundle_download_location))
+        if (g_file_test(hawkbit_config->bundle_download_location, G_FILE_TEST_IS_REGULAR) &&
+            g_remove(hawkbit_config->bundle_download_location))
                 g_warning("Failed to delete file: %s", hawkbit_config->bundle_download_location);
+
+        // additional artifacts of a multi-artifact deployment
+        for (i = 1; ; i++) {
+                g_autofree gchar *file = g_strdup_printf(
+                        "%s.%u", hawkbit_config->bundle_download_location, i);
+
+                if (!g_file_test(file, G_FILE_TEST_IS_REGULAR))
+                        break;
+
+                if (g_remove(file))
+                        g_warning("Failed to delete file: %s", file);
+        }
 }
 
 gboolean install_complete_cb(gpointer ptr)
@@ -798,6 +2434,40 @@ gboolean install_complete_cb(gpointer ptr)
 
         g_mutex_lock(&active_action->mutex);
 
+        // get pending progress out before the closing status
+        flush_progress_feedback_locked();
+
+        last_install_success = result->install_success;
+        install_in_flight = FALSE;
+
+        // intermediate artifact of a multi-artifact deployment: record the
+        // result for the download thread, keep the action open (failures are
+        // closed by the download thread)
+        if (artifacts_pending > 1) {
+                artifacts_pending--;
+
+                if (result->install_success) {
+                        feedback_url = build_api_url("deploymentBase/%s/feedback",
+                                                     active_action->id);
+                        if (!feedback_progress(feedback_url, active_action->id,
+                                               "Artifact installed, deployment continues.",
+                                               &error))
+                                g_warning("%s", error->message);
+                }
+
+                g_cond_signal(&active_action->cond);
+                g_mutex_unlock(&active_action->mutex);
+
+                return G_SOURCE_REMOVE;
+        }
+
+        artifacts_pending = 0;
+
+        // streaming telemetry (if any) ends with the installation
+        g_mutex_lock(&progress_queue_mutex);
+        stream_install_size = 0;
+        g_mutex_unlock(&progress_queue_mutex);
+
         active_action->state = result->install_success ? ACTION_STATE_SUCCESS : ACTION_STATE_ERROR;
         feedback_url = build_api_url("deploymentBase/%s/feedback", active_action->id);
         res = feedback(
@@ -811,6 +2481,11 @@ gboolean install_complete_cb(gpointer ptr)
                 g_warning("%s", error->message);
 
         process_deployment_cleanup();
+        action_journal_remove();
+        // force full processing of the next poll, its content may be
+        // identical (e.g. if the closing feedback did not arrive)
+        conditional_cache_clear();
+        g_cond_signal(&active_action->cond);
         g_mutex_unlock(&active_action->mutex);
 
         if (result->install_success && hawkbit_config->post_update_reboot) {
@@ -823,10 +2498,13 @@ gboolean install_complete_cb(gpointer ptr)
 }
 
 /**
- * @brief Thread to download given Artifact, verfiy its checksum, send hawkBit
- * feedback and call software_ready_cb() callback on success.
+ * @brief Thread to download the given artifacts, verify their checksums, send
+ * hawkBit feedback and hand each artifact over for installation via
+ * software_ready_cb(). With multiple artifacts, the next artifact downloads
+ * while the previous one installs; the single closing status is sent by the
+ * last installation's completion callback, or here on the first failure.
  *
- * @param[in] data Artifact* to process
+ * @param[in] data GPtrArray* of Artifact* to process
  * @return gpointer being 1 (TRUE) if download succeeded, 0 (FALSE) otherwise. The return value is
  *         meant to be used with the GPOINTER_TO_INT() macro only.
  *         Note that if the download thread waited for installation to finish ('run_once' mode),
@@ -834,18 +2512,11 @@ gboolean install_complete_cb(gpointer ptr)
  */
 static gpointer download_thread(gpointer data)
 {
-        struct on_new_software_userdata userdata = {
-                .install_progress_callback = (GSourceFunc) hawkbit_progress,
-                .install_complete_callback = install_complete_cb,
-                .file = hawkbit_config->bundle_download_location,
-                .auth_header = NULL,
-                .ssl_verify = hawkbit_config->ssl_verify,
-                .install_success = FALSE,
-        };
         g_autoptr(GError) error = NULL, feedback_error = NULL;
-        g_autofree gchar *msg = NULL, *sha1sum = NULL;
-        g_autoptr(Artifact) artifact = data;
-        curl_off_t speed;
+        g_autoptr(GPtrArray) artifacts = data;
+        Artifact *artifact = NULL;
+        gboolean install_started = FALSE, install_success = TRUE;
+        guint i;
 
         g_return_val_if_fail(data, NULL);
 
@@ -856,107 +2527,248 @@ static gpointer download_thread(gpointer data)
                 goto cancel;
 
         active_action->state = ACTION_STATE_DOWNLOADING;
+        action_journal_save_locked();
         g_mutex_unlock(&active_action->mutex);
 
-        g_message("Start downloading: %s", artifact->download_url);
+        // random start delay, de-synchronizing fleet downloads behind shared uplinks
+        if (hawkbit_config->download_start_jitter > 0) {
+                guint delay = g_random_int_range(0, hawkbit_config->download_start_jitter + 1);
 
-        while (1) {
-                gboolean resumable = FALSE;
-                GStatBuf bundle_stat;
-                curl_off_t resume_from = 0;
+                g_debug("Delaying download start by %u s (download_start_jitter)", delay);
+
+                while (delay--) {
+                        g_usleep(G_USEC_PER_SEC);
 
-                g_clear_pointer(&sha1sum, g_free);
+                        g_mutex_lock(&active_action->mutex);
+                        if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
+                                goto cancel;
+                        g_mutex_unlock(&active_action->mutex);
+                }
+        }
 
-                // Download software bundle (artifact)
-                if (g_stat(hawkbit_config->bundle_download_location, &bundle_stat) == 0)
-                        resume_from = (curl_off_t) bundle_stat.st_size;
+        for (i = 0; i < artifacts->len; i++) {
+                g_autofree gchar *msg = NULL, *checksum = NULL, *file = NULL;
+                const gchar *expected_checksum = NULL;
+                gboolean from_cache = FALSE;
+                HashType hash_type;
+                curl_off_t speed = 0;
+
+                artifact = g_ptr_array_index(artifacts, i);
+
+                // subsequent artifacts are stored next to the first one
+                file = (i == 0) ? g_strdup(hawkbit_config->bundle_download_location)
+                       : g_strdup_printf("%s.%u", hawkbit_config->bundle_download_location, i);
+
+                // verify the strongest checksum hawkBit published for the artifact
+                hash_type = artifact->sha256 ? HASH_TYPE_SHA256 : HASH_TYPE_SHA1;
+                expected_checksum = artifact->sha256 ? artifact->sha256 : artifact->sha1;
+
+                // satisfy the download from the local bundle cache if possible
+                if (bundle_cache_get(artifact->sha1, file)) {
+                        g_autoptr(Hash) hash = hash_new(hash_type);
+                        g_autoptr(FILE) fp = g_fopen(file, "rb");
+
+                        if (fp && checksum_file_prefix(hash, fp, NULL) &&
+                            !g_strcmp0(expected_checksum, hash_get_string(hash))) {
+                                g_message("Using cached bundle for %s (%u/%u)", artifact->sha1,
+                                          i + 1, artifacts->len);
+                                checksum = g_strdup(expected_checksum);
+                                from_cache = TRUE;
+                        } else {
+                                // corrupt cache content, drop it and download
+                                g_warning("Cached bundle for %s failed verification, dropping",
+                                          artifact->sha1);
+                                bundle_cache_drop(artifact->sha1);
+                                (void) g_remove(file);
+                        }
+                }
 
-                if (get_binary(artifact->download_url, hawkbit_config->bundle_download_location,
-                               resume_from, &sha1sum, &speed, &error))
-                        break;
+                if (!from_cache) {
+                        if (artifacts->len == 1)
+                                g_message("Start downloading: %s", artifact->download_url);
+                        else
+                                g_message("Start downloading (%u/%u): %s", i + 1,
+                                          artifacts->len, artifact->download_url);
+                }
 
-                for (const gint *code = &resumable_codes[0]; *code; code++)
-                        resumable |= g_error_matches(error, RHU_HAWKBIT_CLIENT_CURL_ERROR, *code);
+                // opt-in parallel range download, resume/retry is handled per segment
+                if (from_cache) {
+                        // no transfer needed
+                } else if (hawkbit_config->download_connections > 1 && artifact->size > 0) {
+                        if (!get_binary_parallel(artifact->download_url, file,
+                                                 (curl_off_t) artifact->size,
+                                                 hawkbit_config->download_connections,
+                                                 hash_type, &checksum, &speed, &error)) {
+                                g_prefix_error(&error, "Download failed: ");
+                                goto report_err;
+                        }
+                } else while (1) {
+                        gboolean resumable = FALSE;
+                        GStatBuf bundle_stat;
+                        curl_off_t resume_from = 0;
+
+                        g_clear_pointer(&checksum, g_free);
+
+                        // Download software bundle (artifact)
+                        if (g_stat(file, &bundle_stat) == 0)
+                                resume_from = (curl_off_t) bundle_stat.st_size;
+
+                        if (get_binary(artifact->download_url, file, resume_from,
+                                       (curl_off_t) artifact->size, hash_type, &checksum,
+                                       &speed, &error))
+                                break;
+
+                        for (const gint *code = &resumable_codes[0]; *code; code++)
+                                resumable |= g_error_matches(error,
+                                                             RHU_HAWKBIT_CLIENT_CURL_ERROR,
+                                                             *code);
+
+                        if (!hawkbit_config->resume_downloads || !resumable) {
+                                g_prefix_error(&error, "Download failed: ");
+                                goto report_err;
+                        }
+                        g_debug("%s, resuming download..", curl_easy_strerror(error->code));
+
+                        g_mutex_lock(&active_action->mutex);
+                        if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
+                                goto cancel;
+                        g_mutex_unlock(&active_action->mutex);
 
-                if (!hawkbit_config->resume_downloads || !resumable) {
-                        g_prefix_error(&error, "Download failed: ");
+                        g_clear_error(&error);
+
+                        // sleep 0.5 s before attempting to resume download
+                        g_usleep(500000);
+                }
+
+                // notify hawkbit that download is complete (single-artifact
+                // deployments keep the original message wording)
+                if (artifacts->len == 1)
+                        msg = from_cache
+                              ? g_strdup("Download complete. Provided from local cache.")
+                              : g_strdup_printf("Download complete. %.2f MB/s",
+                                                (double)speed/(1024*1024));
+                else
+                        msg = from_cache
+                              ? g_strdup_printf(
+                                      "Download complete (%u/%u). Provided from local cache.",
+                                      i + 1, artifacts->len)
+                              : g_strdup_printf("Download complete (%u/%u). %.2f MB/s", i + 1,
+                                                artifacts->len, (double)speed/(1024*1024));
+                g_mutex_lock(&active_action->mutex);
+                if (!feedback_progress(artifact->feedback_url, active_action->id, msg, &error)) {
+                        g_warning("%s", error->message);
+                        g_clear_error(&error);
+                }
+                g_mutex_unlock(&active_action->mutex);
+
+                // validate checksum
+                if (g_strcmp0(expected_checksum, checksum)) {
+                        g_set_error(&error, RHU_HAWKBIT_CLIENT_ERROR,
+                                    RHU_HAWKBIT_CLIENT_ERROR_DOWNLOAD,
+                                    "Software: %s V%s. Invalid checksum: %s expected %s",
+                                    artifact->name, artifact->version, checksum,
+                                    expected_checksum);
                         goto report_err;
                 }
-                g_debug("%s, resuming download..", curl_easy_strerror(error->code));
+
+                // retain the verified bundle for future re-deployments
+                if (!from_cache)
+                        bundle_cache_put(artifact->sha1, file);
 
                 g_mutex_lock(&active_action->mutex);
-                if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
-                        goto cancel;
+                // skip installation if hawkBit asked us to do so (only report
+                // once all artifacts are downloaded)
+                if (!artifact->do_install &&
+                    (!artifact->maintenance_window || g_strcmp0(artifact->maintenance_window, "available") == 0)) {
+                        if (i + 1 < artifacts->len) {
+                                g_mutex_unlock(&active_action->mutex);
+                                continue;
+                        }
+
+                        active_action->state = ACTION_STATE_SUCCESS;
+                        action_journal_save_locked();
+                        if (!feedback(artifact->feedback_url, active_action->id, "File checksum OK.", "success",
+                                      "downloaded", &feedback_error))
+                                g_warning("%s", feedback_error->message);
+
+                        g_mutex_unlock(&active_action->mutex);
+                        return GINT_TO_POINTER(TRUE);
+                }
+                if (!feedback_progress(artifact->feedback_url, active_action->id,
+                                       "File checksum OK.", &error)) {
+                        g_warning("%s", error->message);
+                        g_clear_error(&error);
+                }
                 g_mutex_unlock(&active_action->mutex);
 
-                g_clear_error(&error);
+                // last chance to cancel installation
 
-                // sleep 0.5 s before attempting to resume download
-                g_usleep(500000);
-        }
+                g_mutex_lock(&active_action->mutex);
 
-        // notify hawkbit that download is complete
-        msg = g_strdup_printf("Download complete. %.2f MB/s",
-                              (double)speed/(1024*1024));
-        g_mutex_lock(&active_action->mutex);
-        if (!feedback_progress(artifact->feedback_url, active_action->id, msg, &error)) {
-                g_warning("%s", error->message);
-                g_clear_error(&error);
-        }
-        g_mutex_unlock(&active_action->mutex);
+                // wait for the previous artifact's installation to finish
+                while (install_in_flight)
+                        g_cond_wait(&active_action->cond, &active_action->mutex);
 
-        // validate checksum
-        if (g_strcmp0(artifact->sha1, sha1sum)) {
-                g_set_error(&error, RHU_HAWKBIT_CLIENT_ERROR, RHU_HAWKBIT_CLIENT_ERROR_DOWNLOAD,
-                            "Software: %s V%s. Invalid checksum: %s expected %s", artifact->name,
-                            artifact->version, sha1sum, artifact->sha1);
-                goto report_err;
-        }
+                if (install_started && !last_install_success) {
+                        g_set_error(&error, RHU_HAWKBIT_CLIENT_ERROR,
+                                    RHU_HAWKBIT_CLIENT_ERROR_INSTALL,
+                                    "Installation of artifact %u/%u failed, aborting deployment.",
+                                    i, artifacts->len);
+                        goto report_err_locked;
+                }
 
-        g_mutex_lock(&active_action->mutex);
-        // skip installation if hawkBit asked us to do so
-        if (!artifact->do_install &&
-            (!artifact->maintenance_window || g_strcmp0(artifact->maintenance_window, "available") == 0)) {
-                active_action->state = ACTION_STATE_SUCCESS;
-                if (!feedback(artifact->feedback_url, active_action->id, "File checksum OK.", "success",
-                              "downloaded", &feedback_error))
-                        g_warning("%s", feedback_error->message);
+                if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
+                        goto cancel;
 
-                g_mutex_unlock(&active_action->mutex);
-                return GINT_TO_POINTER(TRUE);
-        }
-        if (!feedback_progress(artifact->feedback_url, active_action->id, "File checksum OK.",
-                               &error)) {
-                g_warning("%s", error->message);
-                g_clear_error(&error);
-        }
-        g_mutex_unlock(&active_action->mutex);
+                // skip installation if hawkBit asked us to do so
+                if (!artifact->do_install) {
+                        if (i + 1 < artifacts->len) {
+                                g_mutex_unlock(&active_action->mutex);
+                                continue;
+                        }
 
-        // last chance to cancel installation
+                        active_action->state = ACTION_STATE_NONE;
+                        g_mutex_unlock(&active_action->mutex);
 
-        g_mutex_lock(&active_action->mutex);
-        if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
-                goto cancel;
+                        return GINT_TO_POINTER(TRUE);
+                }
 
-        // skip installation if hawkBit asked us to do so
-        if (!artifact->do_install) {
-                active_action->state = ACTION_STATE_NONE;
+                // start installation of this artifact, cancelations are impossible now
+                active_action->state = ACTION_STATE_INSTALLING;
+                artifacts_pending = artifacts->len - i;
+                install_in_flight = TRUE;
+                g_cond_signal(&active_action->cond);
                 g_mutex_unlock(&active_action->mutex);
 
-                return GINT_TO_POINTER(TRUE);
+                {
+                        struct on_new_software_userdata userdata = {
+                                .install_progress_callback = (GSourceFunc) hawkbit_progress,
+                                .install_complete_callback = install_complete_cb,
+                                .file = file,
+                                .auth_header = NULL,
+                                .ssl_verify = hawkbit_config->ssl_verify,
+                                .install_success = FALSE,
+                        };
+
+                        software_ready_cb(&userdata);
+                        install_started = TRUE;
+                        // only meaningful in 'run_once' mode (synchronous install)
+                        install_success = userdata.install_success;
+                }
         }
 
-        // start installation, cancelations are impossible now
-        active_action->state = ACTION_STATE_INSTALLING;
-        g_cond_signal(&active_action->cond);
-        g_mutex_unlock(&active_action->mutex);
-
-        software_ready_cb(&userdata);
-
-        return GINT_TO_POINTER(userdata.install_success);
+        return GINT_TO_POINTER(install_success);
 
 report_err:
         g_mutex_lock(&active_action->mutex);
+
+        // let a still running installation finish before closing the action,
+        // its completion callback must not send a second closing status and
+        // its bundle file must not be deleted underneath RAUC
+        while (install_in_flight)
+                g_cond_wait(&active_action->cond, &active_action->mutex);
+
+report_err_locked:
         if (!feedback(artifact->feedback_url, active_action->id, error->message, "failure",
                       "closed", &feedback_error))
                 g_warning("%s", feedback_error->message);
@@ -967,7 +2779,14 @@ cancel:
         if (active_action->state == ACTION_STATE_CANCEL_REQUESTED)
                 active_action->state = ACTION_STATE_CANCELED;
 
+        artifacts_pending = 0;
+        install_in_flight = FALSE;
+
         process_deployment_cleanup();
+        action_journal_remove();
+        // force full processing of the next poll, its content may be
+        // identical (e.g. if the closing feedback did not arrive)
+        conditional_cache_clear();
 
         g_cond_signal(&active_action->cond);
         g_mutex_unlock(&active_action->mutex);
@@ -1015,6 +2834,12 @@ static gboolean start_streaming_installation(Artifact *artifact, GError **error)
         g_cond_signal(&active_action->cond);
         g_mutex_unlock(&active_action->mutex);
 
+        // enable stream throughput estimation for the progress bridge
+        g_mutex_lock(&progress_queue_mutex);
+        stream_install_size = artifact->size;
+        stream_install_started_at = g_get_monotonic_time();
+        g_mutex_unlock(&progress_queue_mutex);
+
         software_ready_cb(&userdata);
 
         g_mutex_lock(&active_action->mutex);
@@ -1030,6 +2855,31 @@ static gboolean start_streaming_installation(Artifact *artifact, GError **error)
         return TRUE;
 }
 
+/**
+ * @brief Select a casync-based delta artifact from the deployment's artifacts.
+ *        Delta artifacts are recognized by "casync" in their filename; chunk
+ *        seeding from the installed system is handled by RAUC itself.
+ *
+ * @param[in] json_artifacts JsonArray* of the deployment's artifacts
+ * @return JsonNode*, borrowed delta artifact element, NULL if none offered
+ */
+static JsonNode* select_delta_artifact(JsonArray *json_artifacts)
+{
+        guint i;
+
+        for (i = 0; i < json_array_get_length(json_artifacts); i++) {
+                JsonNode *candidate = json_array_get_element(json_artifacts, i);
+                g_autofree gchar *filename = json_get_string(candidate, "$.filename", NULL);
+
+                if (filename && strstr(filename, "casync")) {
+                        g_debug("Selected delta artifact %s", filename);
+                        return candidate;
+                }
+        }
+
+        return NULL;
+}
+
 /**
  * @brief Process hawkBit deployment described by req_root.
  *        Must be called under locked active_action->mutex.
@@ -1040,14 +2890,18 @@ static gboolean start_streaming_installation(Artifact *artifact, GError **error)
  */
 static gboolean process_deployment(JsonNode *req_root, GError **error)
 {
-        g_autoptr(Artifact) artifact = g_new0(Artifact, 1);
+        g_autoptr(GPtrArray) artifacts = NULL;
         g_autofree gchar *deployment = NULL, *temp_id = NULL,
                          *deployment_download = NULL, *deployment_update = NULL,
-                         *maintenance_window = NULL, *maintenance_msg = NULL;
+                         *maintenance_window = NULL, *maintenance_msg = NULL,
+                         *feedback_url = NULL;
         g_autoptr(JsonParser) json_response_parser = NULL;
-        g_autoptr(JsonArray) json_chunks = NULL, json_artifacts = NULL;
-        JsonNode *resp_root = NULL, *json_chunk = NULL, *json_artifact = NULL;
+        g_autoptr(JsonArray) json_chunks = NULL;
+        JsonNode *resp_root = NULL;
+        gboolean do_install;
+        gint64 total_size = 0;
         goffset freespace;
+        guint c;
 
         g_return_val_if_fail(req_root, FALSE);
         g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
@@ -1068,14 +2922,13 @@ static gboolean process_deployment(JsonNode *req_root, GError **error)
                 goto error;
 
         // get deployment resource
-        if (!rest_request(GET, deployment, NULL, &json_response_parser, error))
+        if (!rest_request(GET, deployment, NULL, &json_response_parser, NULL, NULL, error))
                 goto error;
 
         resp_root = json_parser_get_root(json_response_parser);
 
         // handle deployment.maintenanceWindow (only available if maintenance window is defined)
         maintenance_window = json_get_string(resp_root, "$.deployment.maintenanceWindow", NULL);
-        artifact->maintenance_window = g_strdup(maintenance_window);
         maintenance_msg = maintenance_window
                           ? g_strdup_printf(" (maintenance window is '%s')", maintenance_window)
                           : g_strdup("");
@@ -1097,15 +2950,15 @@ static gboolean process_deployment(JsonNode *req_root, GError **error)
         if (!deployment_update)
                 goto error;
 
-        artifact->do_install = g_strcmp0(deployment_update, "skip") != 0;
-        if (!artifact->do_install)
+        do_install = g_strcmp0(deployment_update, "skip") != 0;
+        if (!do_install)
                 g_message("hawkBit requested to skip installation, not invoking RAUC yet%s.",
                           maintenance_msg);
 
         // remember deployment's action id
         temp_id = json_get_string(resp_root, "$.id", error);
 
-        if (!artifact->do_install && !g_strcmp0(temp_id, active_action->id)) {
+        if (!do_install && !g_strcmp0(temp_id, active_action->id)) {
                 g_debug("Deployment %s is still waiting%s.", active_action->id, maintenance_msg);
                 active_action->state = ACTION_STATE_NONE;
                 return TRUE;
@@ -1123,77 +2976,119 @@ static gboolean process_deployment(JsonNode *req_root, GError **error)
         if (!active_action->id)
                 goto error;
 
-        artifact->feedback_url = build_api_url("deploymentBase/%s/feedback", active_action->id);
+        action_journal_save_locked();
+
+        feedback_url = build_api_url("deploymentBase/%s/feedback", active_action->id);
 
-        // downloading multiple chunks not supported, only first chunk is downloaded (RAUC bundle)
         json_chunks = json_get_array(resp_root, "$.deployment.chunks", error);
         if (!json_chunks)
                 goto proc_error;
-        if (json_array_get_length(json_chunks) > 1) {
+
+        // streaming installations hand a single bundle URL to RAUC
+        if (hawkbit_config->stream_bundle && json_array_get_length(json_chunks) > 1) {
                 g_set_error(error, RHU_HAWKBIT_CLIENT_ERROR, RHU_HAWKBIT_CLIENT_ERROR_MULTI_CHUNKS,
-                            "Deployment %s unsupported: cannot handle multiple chunks.", active_action->id);
+                            "Deployment %s unsupported: cannot stream multiple chunks.",
+                            active_action->id);
                 goto proc_error;
         }
 
-        json_chunk = json_array_get_element(json_chunks, 0);
+        artifacts = g_ptr_array_new_with_free_func((GDestroyNotify) artifact_free);
 
-        // downloading multiple artifacts not supported, only first artifact is downloaded (RAUC bundle)
-        json_artifacts = json_get_array(json_chunk, "$.artifacts", error);
-        if (!json_artifacts)
-                goto proc_error;
-        if (json_array_get_length(json_artifacts) > 1) {
-                g_set_error(error, RHU_HAWKBIT_CLIENT_ERROR, RHU_HAWKBIT_CLIENT_ERROR_MULTI_ARTIFACTS,
-                            "Deployment %s unsupported: cannot handle multiple artifacts.",
-                            active_action->id);
-                goto proc_error;
-        }
+        // one artifact (RAUC bundle) per chunk
+        for (c = 0; c < json_array_get_length(json_chunks); c++) {
+                g_autoptr(JsonArray) json_artifacts = NULL;
+                JsonNode *json_chunk = NULL, *json_artifact = NULL;
+                Artifact *artifact = g_new0(Artifact, 1);
 
-        json_artifact = json_array_get_element(json_artifacts, 0);
+                g_ptr_array_add(artifacts, artifact);
 
-        // get artifact information
-        artifact->version = json_get_string(json_chunk, "$.version", error);
-        if (!artifact->version)
-                goto proc_error;
+                artifact->feedback_url = g_strdup(feedback_url);
+                artifact->maintenance_window = g_strdup(maintenance_window);
+                artifact->do_install = do_install;
 
-        artifact->name = json_get_string(json_chunk, "$.name", error);
-        if (!artifact->name)
-                goto proc_error;
+                json_chunk = json_array_get_element(json_chunks, c);
 
-        artifact->size = json_get_int(json_artifact, "$.size", error);
-        if (!artifact->size && error)
-                goto proc_error;
+                json_artifacts = json_get_array(json_chunk, "$.artifacts", error);
+                if (!json_artifacts)
+                        goto proc_error;
 
-        artifact->sha1 = json_get_string(json_artifact, "$.hashes.sha1", error);
-        if (!artifact->sha1)
-                goto proc_error;
+                // prefer a delta artifact if configured and offered, fall back to the full bundle
+                if (hawkbit_config->prefer_delta)
+                        json_artifact = select_delta_artifact(json_artifacts);
 
-        // favour https download
-        artifact->download_url = json_get_string(json_artifact, "$._links.download.href", NULL);
-        if (!artifact->download_url)
-                artifact->download_url = json_get_string(
-                        json_artifact, "$._links.download-http.href", error);
+                if (!json_artifact) {
+                        // multiple artifacts within one chunk are ambiguous
+                        if (json_array_get_length(json_artifacts) > 1) {
+                                g_set_error(error, RHU_HAWKBIT_CLIENT_ERROR,
+                                            RHU_HAWKBIT_CLIENT_ERROR_MULTI_ARTIFACTS,
+                                            "Deployment %s unsupported: cannot handle multiple artifacts per chunk.",
+                                            active_action->id);
+                                goto proc_error;
+                        }
 
-        if (!artifact->download_url) {
-                g_prefix_error(error, "\"$._links.download{-http,}.href\": ");
-                goto proc_error;
-        }
+                        json_artifact = json_array_get_element(json_artifacts, 0);
+                }
+
+                // get artifact information
+                artifact->version = json_get_string(json_chunk, "$.version", error);
+                if (!artifact->version)
+                        goto proc_error;
+
+                artifact->name = json_get_string(json_chunk, "$.name", error);
+                if (!artifact->name)
+                        goto proc_error;
+
+                artifact->size = json_get_int(json_artifact, "$.size", error);
+                if (!artifact->size && error)
+                        goto proc_error;
 
-        g_message("New software ready for download (Name: %s, Version: %s, Size: %" G_GINT64_FORMAT " bytes, URL: %s)",
-                  artifact->name, artifact->version, artifact->size, artifact->download_url);
+                artifact->sha1 = json_get_string(json_artifact, "$.hashes.sha1", error);
+                if (!artifact->sha1)
+                        goto proc_error;
+
+                // optional, preferred for verification if published
+                artifact->sha256 = json_get_string(json_artifact, "$.hashes.sha256", NULL);
+
+                // favour https download
+                artifact->download_url = json_get_string(json_artifact,
+                                                         "$._links.download.href", NULL);
+                if (!artifact->download_url)
+                        artifact->download_url = json_get_string(
+                                json_artifact, "$._links.download-http.href", error);
+
+                if (!artifact->download_url) {
+                        g_prefix_error(error, "\"$._links.download{-http,}.href\": ");
+                        goto proc_error;
+                }
+
+                total_size += artifact->size;
+
+                g_message("New software ready for download (Name: %s, Version: %s, Size: %" G_GINT64_FORMAT " bytes, URL: %s)",
+                          artifact->name, artifact->version, artifact->size, artifact->download_url);
+        }
 
         // stream_bundle path exits early
         if (hawkbit_config->stream_bundle)
-                return start_streaming_installation(artifact, error);
+                return start_streaming_installation(g_ptr_array_index(artifacts, 0), error);
 
-        // check if there is enough free diskspace
+        // check if there is enough free diskspace for all artifacts
         if (!get_available_space(hawkbit_config->bundle_download_location, &freespace, error))
                 goto proc_error;
 
-        if (freespace < artifact->size) {
+        // make room by dropping cached bundles before giving up
+        if (freespace < total_size && hawkbit_config->bundle_cache_dir) {
+                bundle_cache_evict(0, total_size);
+
+                if (!get_available_space(hawkbit_config->bundle_download_location, &freespace,
+                                         error))
+                        goto proc_error;
+        }
+
+        if (freespace < total_size) {
                 // notify hawkbit that there is not enough free space
                 g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOSPC,
                             "File size %" G_GINT64_FORMAT " exceeds available space %" G_GOFFSET_FORMAT,
-                            artifact->size, freespace);
+                            total_size, freespace);
                 goto proc_error;
         }
 
@@ -1203,16 +3098,17 @@ static gboolean process_deployment(JsonNode *req_root, GError **error)
 
         // start download thread
         thread_download = g_thread_new("downloader", download_thread,
-                                       (gpointer) g_steal_pointer(&artifact));
+                                       (gpointer) g_steal_pointer(&artifacts));
 
         return TRUE;
 
 proc_error:
-        feedback(artifact->feedback_url, active_action->id, (*error)->message, "failure", "closed", NULL);
+        feedback(feedback_url, active_action->id, (*error)->message, "failure", "closed", NULL);
 
 error:
         // clean up failed deployment
         process_deployment_cleanup();
+        action_journal_remove();
         active_action->state = ACTION_STATE_NONE;
 
         return FALSE;
@@ -1241,7 +3137,7 @@ static gboolean process_cancel(JsonNode *req_root, GError **error)
                 return FALSE;
 
         // retrieve cancel details
-        if (!rest_request(GET, cancel_url, NULL, &json_response_parser, error))
+        if (!rest_request(GET, cancel_url, NULL, &json_response_parser, NULL, NULL, error))
                 return FALSE;
 
         resp_root = json_parser_get_root(json_response_parser);
@@ -1315,46 +3211,138 @@ void hawkbit_init(Config *config, GSourceFunc on_install_ready)
 
         hawkbit_config = config;
         software_ready_cb = on_install_ready;
-        curl_global_init(CURL_GLOBAL_ALL);
+        curl_handle_pool = g_ptr_array_new();
+        curl_multi_pool = g_ptr_array_new();
+        progress_queue = g_ptr_array_new_with_free_func(g_free);
+        metrics_init(config->metrics_file);
+        // libcurl itself is initialized lazily on the first request
 }
 
 typedef struct ClientData_ {
+        GMainContext *context;
         GMainLoop *loop;
         gboolean res;
         long hawkbit_interval_check_sec;
-        long last_run_sec;
 } ClientData;
 
+static gboolean hawkbit_pull_cb(gpointer user_data);
+
+/**
+ * @brief Arm a one-shot timeout source firing hawkbit_pull_cb() after
+ *        delay_sec seconds. The poll callback re-arms itself for the next
+ *        deadline, so the process makes no wakeups between polls.
+ *
+ * @param[in] data      ClientData*
+ * @param[in] delay_sec Delay in seconds until the next poll
+ */
+static void schedule_hawkbit_pull(ClientData *data, long delay_sec)
+{
+        g_autoptr(GSource) timeout_source = NULL;
+
+        g_return_if_fail(data);
+
+        timeout_source = g_timeout_source_new_seconds((guint) delay_sec);
+        g_source_set_name(timeout_source, "hawkBit poll");
+        g_source_set_callback(timeout_source, (GSourceFunc) hawkbit_pull_cb, data, NULL);
+        g_source_attach(timeout_source, data->context);
+}
+
+/**
+ * @brief Release cached resources before a long idle period: drop pooled Curl
+ *        handles (their connections would time out while idle anyway, they
+ *        are recreated lazily) and return freed heap pages to the OS. On
+ *        low-RAM devices this trims several MB of RSS between polls.
+ *
+ * @param[in] sleep_sec Seconds until the next poll, reported via sd_notify()
+ */
+static void idle_trim(long sleep_sec)
+{
+        guint dropped = 0;
+
+        g_mutex_lock(&curl_handle_pool_mutex);
+        if (curl_handle_pool) {
+                dropped += curl_handle_pool->len;
+                while (curl_handle_pool->len)
+                        curl_easy_cleanup(g_ptr_array_remove_index(
+                                                  curl_handle_pool,
+                                                  curl_handle_pool->len - 1));
+        }
+        g_mutex_unlock(&curl_handle_pool_mutex);
+
+        g_mutex_lock(&curl_multi_pool_mutex);
+        if (curl_multi_pool) {
+                dropped += curl_multi_pool->len;
+                while (curl_multi_pool->len)
+                        curl_multi_cleanup(g_ptr_array_remove_index(
+                                                   curl_multi_pool,
+                                                   curl_multi_pool->len - 1));
+        }
+        g_mutex_unlock(&curl_multi_pool_mutex);
+
+        g_debug("Idle trim: released %u cached curl handles", dropped);
+
+#ifdef __GLIBC__
+        malloc_trim(0);
+#endif
+
+#ifdef WITH_SYSTEMD
+        {
+                g_autofree gchar *statm = NULL;
+                glong rss_pages = 0;
+
+                if (g_file_get_contents("/proc/self/statm", &statm, NULL, NULL) &&
+                    sscanf(statm, "%*ld %ld", &rss_pages) == 1) {
+                        g_autofree gchar *status = g_strdup_printf(
+                                "STATUS=Idle, next poll in %ld s (RSS: %ld KiB)", sleep_sec,
+                                rss_pages * (sysconf(_SC_PAGESIZE) / 1024));
+
+                        sd_notify(0, status);
+                }
+        }
+#endif
+}
+
 /**
- * @brief Callback for main loop, should run regularly, polls controller base poll resource and
- * triggers appropriate actions.
+ * @brief Callback for main loop, fires once per poll deadline, polls controller base poll
+ * resource, triggers appropriate actions and re-arms itself for the next poll deadline.
  *
  * @param[in] user_data ClientData*
- * @return TRUE if polling controller base resource and running appropriate actions succeeded,
- *         FALSE otherwise
+ * @return G_SOURCE_REMOVE is always returned, the next poll is scheduled via
+ *         schedule_hawkbit_pull()
  */
 static gboolean hawkbit_pull_cb(gpointer user_data)
 {
         ClientData *data = user_data;
-        gboolean res = FALSE;
+        gboolean res = FALSE, unmodified = FALSE, action_in_progress = FALSE;
+        gboolean commit_validators = TRUE;
         g_autoptr(GError) error = NULL;
         g_autofree gchar *get_tasks_url = NULL;
         g_autoptr(JsonParser) json_response_parser = NULL;
         JsonNode *json_root = NULL;
 
-        g_return_val_if_fail(user_data, FALSE);
-
-        if (++data->last_run_sec < data->hawkbit_interval_check_sec)
-                return G_SOURCE_CONTINUE;
-
-        data->last_run_sec = 0;
+        g_return_val_if_fail(user_data, G_SOURCE_REMOVE);
 
         // build hawkBit get tasks URL
         get_tasks_url = build_api_url(NULL);
 
         g_message("Checking for new software...");
-        res = rest_request(GET, get_tasks_url, NULL, &json_response_parser, &error);
+
+        // no action mutex held here, other sources may dispatch during transfers
+        context_dispatch_allowed = TRUE;
+
+        res = rest_request(GET, get_tasks_url, NULL, &json_response_parser, NULL, &unmodified,
+                           &error);
+        metrics_record_poll(res);
+
+        // steady state: nothing changed since the last poll, skip processing
+        // and keep the current interval
+        if (res && unmodified) {
+                context_dispatch_allowed = FALSE;
+                goto out;
+        }
+
         if (!res) {
+                context_dispatch_allowed = FALSE;
                 if (g_error_matches(error, RHU_HAWKBIT_CLIENT_HTTP_ERROR, 401)) {
                         if (hawkbit_config->auth_token)
                                 g_warning("Failed to authenticate. Check if auth_token is correct?");
@@ -1372,15 +3360,36 @@ static gboolean hawkbit_pull_cb(gpointer user_data)
         // owned by the JsonParser and should never be modified or freed
         json_root = json_parser_get_root(json_response_parser);
 
-        if (json_contains(json_root, "$._links.configData")) {
+        // during an active action, polls are cancel-only checks: skip the
+        // configData upload and deployment processing (the latter would only
+        // report "already in progress")
+        g_mutex_lock(&active_action->mutex);
+        action_in_progress = active_action->state >= ACTION_STATE_PROCESSING;
+        g_mutex_unlock(&active_action->mutex);
+
+        if (!action_in_progress && json_contains(json_root, "$._links.configData")) {
+                gboolean uploaded = FALSE;
+
                 // hawkBit has asked us to identify ourselves
-                res = identify(&error);
+                res = identify(&uploaded, &error);
                 if (!res) {
                         g_warning("%s", error->message);
                         g_clear_error(&error);
+                        commit_validators = FALSE;
                 }
+
+                // a skipped upload must be re-evaluated on the next poll even
+                // if the response stays identical: hawkBit drops the
+                // configData link once it received the attributes, so a
+                // persisting link forces the upload then
+                if (res && !uploaded)
+                        commit_validators = FALSE;
         }
-        if (json_contains(json_root, "$._links.deploymentBase")) {
+        // deployment/cancel processing locks active_action->mutex which
+        // dispatched sources may lock, too
+        context_dispatch_allowed = FALSE;
+
+        if (!action_in_progress && json_contains(json_root, "$._links.deploymentBase")) {
                 // hawkBit has a new deployment for us
                 g_mutex_lock(&active_action->mutex);
                 res = process_deployment(json_root, &error);
@@ -1391,8 +3400,10 @@ static gboolean hawkbit_pull_cb(gpointer user_data)
                                 g_debug("%s", error->message);
                         else
                                 g_warning("%s", error->message);
+
+                        commit_validators = FALSE;
                 }
-        } else {
+        } else if (!action_in_progress) {
                 g_message("No new software.");
         }
         if (json_contains(json_root, "$._links.cancelAction")) {
@@ -1400,13 +3411,22 @@ static gboolean hawkbit_pull_cb(gpointer user_data)
                 if (!res) {
                         g_warning("%s", error->message);
                         g_clear_error(&error);
+                        commit_validators = FALSE;
                 }
         }
 
+        // only skip future identical responses if this one was fully
+        // processed; identical content after failed processing must be
+        // processed again
+        if (commit_validators)
+                conditional_cache_commit(get_tasks_url);
+
         // get hawkbit sleep time (how often should we check for new software)
         data->hawkbit_interval_check_sec = json_get_sleeptime(json_root);
 
 out:
+        metrics_write();
+
         if (run_once) {
                 if (thread_download) {
                         gpointer thread_ret = g_thread_join(thread_download);
@@ -1414,18 +3434,24 @@ out:
                 }
 
                 data->res = res;
-                g_main_loop_quit(data->loop);
+                // no main loop to quit on the direct single-shot path
+                if (data->loop)
+                        g_main_loop_quit(data->loop);
                 return G_SOURCE_REMOVE;
         }
 
-        return G_SOURCE_CONTINUE;
+        // trim cached resources on the way into long idle periods
+        if (data->hawkbit_interval_check_sec > IDLE_TRIM_THRESHOLD_SEC)
+                idle_trim(data->hawkbit_interval_check_sec);
+
+        schedule_hawkbit_pull(data, data->hawkbit_interval_check_sec);
+        return G_SOURCE_REMOVE;
 }
 
 int hawkbit_start_service_sync()
 {
         g_autoptr(GMainContext) ctx = NULL;
         ClientData cdata;
-        g_autoptr(GSource) timeout_source = NULL;
         int res = 0;
 #ifdef WITH_SYSTEMD
         g_autoptr(GSource) event_source = NULL;
@@ -1433,17 +3459,29 @@ int hawkbit_start_service_sync()
 #endif
 
         active_action = action_new();
+        action_journal_load();
+
+        // single-shot mode: poll synchronously and exit, skipping main loop,
+        // timer and watchdog setup entirely
+        if (run_once) {
+                cdata.context = NULL;
+                cdata.loop = NULL;
+                cdata.res = FALSE;
+                cdata.hawkbit_interval_check_sec = 0;
+
+                hawkbit_pull_cb(&cdata);
+
+                return cdata.res ? 0 : 1;
+        }
 
         ctx = g_main_context_new();
+        client_context = ctx;
+        cdata.context = ctx;
         cdata.loop = g_main_loop_new(ctx, FALSE);
         cdata.hawkbit_interval_check_sec = hawkbit_config->retry_wait;
-        cdata.last_run_sec = hawkbit_config->retry_wait;
 
-        // pull every second
-        timeout_source = g_timeout_source_new(1000);
-        g_source_set_name(timeout_source, "Add timeout");
-        g_source_set_callback(timeout_source, (GSourceFunc) hawkbit_pull_cb, &cdata, NULL);
-        g_source_attach(timeout_source, ctx);
+        // first poll without delay, polls re-arm themselves for the next deadline
+        schedule_hawkbit_pull(&cdata, 0);
 
 #ifdef WITH_SYSTEMD
         res = sd_event_default(&event);
@@ -1481,6 +3519,7 @@ finish:
         g_source_destroy(event_source);
         sd_event_set_watchdog(event, FALSE);
 #endif
+        client_context = NULL;
         g_main_loop_unref(cdata.loop);
         if (res < 0)
                 g_warning("%s", strerror(-res));
@@ -1498,6 +3537,7 @@ void artifact_free(Artifact *artifact)
         g_free(artifact->download_url);
         g_free(artifact->feedback_url);
         g_free(artifact->sha1);
+        g_free(artifact->sha256);
         g_free(artifact->maintenance_window);
         g_free(artifact);
 }
@@ -10,57 +10,119 @@
 #include <stddef.h>
 
 
+static GHashTable *compiled_paths = NULL;
+static GMutex compiled_paths_mutex;
+
 /**
- * @brief Get the first JsonNode element matching path in json_node.
+ * @brief Get compiled JsonPath for path, compiling it on first use. Compiled
+ *        expressions are cached forever, the helpers are only used with a
+ *        fixed set of DDI API paths.
+ *
+ * @param[in]  path  JSONPath expression
+ * @param[out] error Error
+ * @return JsonPath*, borrowed compiled expression (owned by the cache), NULL
+ *         on compile error (error set)
+ */
+static JsonPath* get_compiled_path(const gchar *path, GError **error)
+{
+        JsonPath *jpath = NULL;
+
+        g_mutex_lock(&compiled_paths_mutex);
+
+        if (!compiled_paths)
+                compiled_paths = g_hash_table_new_full(g_str_hash, g_str_equal, g_free,
+                                                       g_object_unref);
+
+        jpath = g_hash_table_lookup(compiled_paths, path);
+        if (!jpath) {
+                jpath = json_path_new();
+                if (!json_path_compile(jpath, path, error)) {
+                        g_object_unref(jpath);
+                        jpath = NULL;
+                } else {
+                        g_hash_table_insert(compiled_paths, g_strdup(path), jpath);
+                }
+        }
+
+        g_mutex_unlock(&compiled_paths_mutex);
+
+        return jpath;
+}
+
+/**
+ * @brief Evaluate path on json_node using the compiled expression cache.
  *
  * @param[in]  json_node JsonNode to query
  * @param[in]  path      Query path
  * @param[out] error     Error
- * @return JsonNode*, matching JsonNode element (must be freed), NULL on error
+ * @return JsonNode* holding the array of matches (must be freed), NULL on
+ *         compile error (error set)
  */
-static JsonNode* json_get_first_matching_element(JsonNode *json_node, const gchar *path,
-                                                 GError **error)
+static JsonNode* json_path_query_cached(JsonNode *json_node, const gchar *path, GError **error)
 {
-        g_autoptr(JsonNode) match = NULL, node = NULL;
-        JsonArray *arr = NULL;
+        JsonPath *jpath = NULL;
 
         g_return_val_if_fail(json_node, NULL);
         g_return_val_if_fail(path, NULL);
         g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-        match = json_path_query(path, json_node, error);
-        if (!match)
+        jpath = get_compiled_path(path, error);
+        if (!jpath)
                 return NULL;
 
-        arr = json_node_get_array(match);
+        return json_path_match(jpath, json_node);
+}
+
+/**
+ * @brief Get the first JsonNode element matching path in json_node, without
+ *        copying it out of the result set.
+ *
+ * @param[in]  json_node JsonNode to query
+ * @param[in]  path      Query path
+ * @param[out] match     Return location for the result set the returned
+ *                       element is borrowed from (must be freed)
+ * @param[out] error     Error
+ * @return JsonNode*, matching element borrowed from match (valid as long as
+ *         match is), NULL on error
+ */
+static JsonNode* json_get_first_matching_element(JsonNode *json_node, const gchar *path,
+                                                 JsonNode **match, GError **error)
+{
+        JsonArray *arr = NULL;
+
+        g_return_val_if_fail(match && *match == NULL, NULL);
+
+        *match = json_path_query_cached(json_node, path, error);
+        if (!*match)
+                return NULL;
+
+        arr = json_node_get_array(*match);
         if (!arr) {
                 g_set_error(error, JSON_PARSER_ERROR, JSON_PARSER_ERROR_PARSE,
                             "Failed to retrieve array from node for path %s", path);
                 return NULL;
         }
 
-        if (json_array_get_length(arr) > 0)
-                node = json_array_dup_element(arr, 0);
-
-        if (!node) {
+        if (!json_array_get_length(arr)) {
                 g_set_error(error, JSON_PARSER_ERROR, JSON_PARSER_ERROR_PARSE,
                             "Failed to retrieve element from array for path %s", path);
                 return NULL;
         }
 
-        return g_steal_pointer(&node);
+        return json_array_get_element(arr, 0);
 }
 
 gchar* json_get_string(JsonNode *json_node, const gchar *path, GError **error)
 {
         g_autofree gchar *res_str = NULL;
-        g_autoptr(JsonNode) result = NULL;
+        g_autoptr(JsonNode) match = NULL;
+        JsonNode *result = NULL;
 
         g_return_val_if_fail(json_node, NULL);
         g_return_val_if_fail(path, NULL);
         g_return_val_if_fail(error == NULL || *error == NULL, NULL);
 
-        result = json_get_first_matching_element(json_node, path, error);
+        result = json_get_first_matching_element(json_node, path, &match, error);
         if (!result)
                 return NULL;
 
@@ -76,13 +138,14 @@ gchar* json_get_string(JsonNode *json_node, const gchar *path, GError **error)
 
 gint64 json_get_int(JsonNode *json_node, const gchar *path, GError **error)
 {
-        g_autoptr(JsonNode) result = NULL;
+        g_autoptr(JsonNode) match = NULL;
+        JsonNode *result = NULL;
 
         g_return_val_if_fail(json_node, 0);
         g_return_val_if_fail(path, 0);
         g_return_val_if_fail(error == NULL || *error == NULL, 0);
 
-        result = json_get_first_matching_element(json_node, path, error);
+        result = json_get_first_matching_element(json_node, path, &match, error);
         if (!result)
                 return 0;
 
@@ -98,13 +161,14 @@ gint64 json_get_int(JsonNode *json_node, const gchar *path, GError **error)
 JsonArray* json_get_array(JsonNode *json_node, const gchar *path, GError **error)
 {
         g_autoptr(JsonArray) res_arr = NULL;
-        g_autoptr(JsonNode) result = NULL;
+        g_autoptr(JsonNode) match = NULL;
+        JsonNode *result = NULL;
 
         g_return_val_if_fail(error == NULL || *error == NULL, NULL);
         g_return_val_if_fail(json_node, NULL);
         g_return_val_if_fail(path, NULL);
 
-        result = json_get_first_matching_element(json_node, path, error);
+        result = json_get_first_matching_element(json_node, path, &match, error);
         if (!result)
                 return NULL;
 
@@ -132,7 +196,7 @@ gboolean json_contains(JsonNode *json_node, gchar *path)
         g_return_val_if_fail(json_node, FALSE);
         g_return_val_if_fail(path, FALSE);
 
-        node = json_path_query(path, json_node, &error);
+        node = json_path_query_cached(json_node, path, &error);
         if (!node) {
                 // failed to compile expression to JSONPath
                 g_warning("%s", error->message);
@@ -9,8 +9,27 @@
 #include "log.h"
 #include <stddef.h>
 
+#define LOG_RING_SIZE 256
+
+/**
+ * @brief A log message queued for the asynchronous writer.
+ */
+struct log_entry {
+        GLogLevelFlags level;         /**< log level of the message */
+        gchar *message;               /**< owned message string */
+};
+
 static gboolean output_to_systemd = FALSE;
 
+// asynchronous logging state: fixed ring buffer drained by a writer thread,
+// so a blocked console or syslog socket never stalls producing threads
+static gboolean log_async = FALSE;
+static struct log_entry log_ring[LOG_RING_SIZE];
+static guint log_ring_head = 0, log_ring_tail = 0, log_ring_count = 0;
+static guint log_ring_dropped = 0;
+static GMutex log_ring_mutex;
+static GCond log_ring_cond;
+
 /**
  * @brief convert GLogLevelFlags to string
  *
@@ -66,17 +85,13 @@ static int log_level_to_int(GLogLevelFlags level)
 #endif
 
 /**
- * @brief     Glib log handler callback
+ * @brief     Write a log message to its destination (stdout/stderr or the
+ *            systemd journal). This is the potentially blocking part.
  *
- * @param[in] log_domain Log domain
  * @param[in] log_level  Log level
  * @param[in] message    Log message
- * @param[in] user_data  Not used
  */
-static void log_handler_cb(const gchar    *log_domain,
-                           GLogLevelFlags log_level,
-                           const gchar    *message,
-                           gpointer user_data)
+static void log_emit(GLogLevelFlags log_level, const gchar *message)
 {
         const gchar *log_level_str;
 #ifdef WITH_SYSTEMD
@@ -96,9 +111,92 @@ static void log_handler_cb(const gchar    *log_domain,
 #endif
 }
 
-void setup_logging(const gchar *domain, GLogLevelFlags level, gboolean p_output_to_systemd)
+/**
+ * @brief Writer thread draining the log ring in batches.
+ *
+ * @param[in] data Not used
+ * @return NULL, the writer never exits
+ */
+static gpointer log_writer_thread(gpointer data)
+{
+        while (1) {
+                struct log_entry batch[LOG_RING_SIZE];
+                guint count = 0, dropped = 0, i;
+
+                g_mutex_lock(&log_ring_mutex);
+                while (!log_ring_count && !log_ring_dropped)
+                        g_cond_wait(&log_ring_cond, &log_ring_mutex);
+
+                while (log_ring_count) {
+                        batch[count++] = log_ring[log_ring_tail];
+                        log_ring_tail = (log_ring_tail + 1) % LOG_RING_SIZE;
+                        log_ring_count--;
+                }
+
+                dropped = log_ring_dropped;
+                log_ring_dropped = 0;
+                g_mutex_unlock(&log_ring_mutex);
+
+                for (i = 0; i < count; i++) {
+                        log_emit(batch[i].level, batch[i].message);
+                        g_free(batch[i].message);
+                }
+
+                if (dropped) {
+                        g_autofree gchar *msg = g_strdup_printf(
+                                "%u log message(s) dropped (ring buffer full)", dropped);
+                        log_emit(G_LOG_LEVEL_WARNING, msg);
+                }
+        }
+
+        return NULL;
+}
+
+/**
+ * @brief     Glib log handler callback
+ *
+ * @param[in] log_domain Log domain
+ * @param[in] log_level  Log level
+ * @param[in] message    Log message
+ * @param[in] user_data  Not used
+ */
+static void log_handler_cb(const gchar    *log_domain,
+                           GLogLevelFlags log_level,
+                           const gchar    *message,
+                           gpointer user_data)
+{
+        // fatal messages abort right after the handler, emit them in line;
+        // criticals are made always-fatal in main() without getting
+        // G_LOG_FLAG_FATAL set, so they must be included here explicitly
+        if (log_async &&
+            !(log_level & (G_LOG_FLAG_FATAL | G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL))) {
+                g_mutex_lock(&log_ring_mutex);
+                if (log_ring_count < LOG_RING_SIZE) {
+                        log_ring[log_ring_head].level = log_level;
+                        log_ring[log_ring_head].message = g_strdup(message);
+                        log_ring_head = (log_ring_head + 1) % LOG_RING_SIZE;
+                        log_ring_count++;
+                        g_cond_signal(&log_ring_cond);
+                } else {
+                        // account instead of blocking the producing thread
+                        log_ring_dropped++;
+                }
+                g_mutex_unlock(&log_ring_mutex);
+                return;
+        }
+
+        log_emit(log_level, message);
+}
+
+void setup_logging(const gchar *domain, GLogLevelFlags level, gboolean p_output_to_systemd,
+                   gboolean async)
 {
         output_to_systemd = p_output_to_systemd;
+        log_async = async;
+
+        if (log_async)
+                g_thread_new("logger", log_writer_thread, NULL);
+
         g_log_set_handler(NULL,
                           level | G_LOG_FLAG_FATAL | G_LOG_FLAG_RECURSION,
                           log_handler_cb, NULL);
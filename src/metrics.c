@@ -0,0 +1,169 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * SPDX-FileCopyrightText: 2022 Prevas A/S (www.prevas.com)
+ *
+ * @file
+ * @brief Runtime metrics: transfer latency histograms and poll counters,
+ *        exported as a Prometheus-format textfile for fleet monitoring.
+ */
+
+#include "metrics.h"
+#include <stddef.h>
+
+
+#define HISTOGRAM_BUCKETS 10
+
+// upper bucket bounds in seconds, +Inf is implicit
+static const double bucket_bounds[HISTOGRAM_BUCKETS] = {
+        0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10
+};
+
+/**
+ * @brief Fixed-bucket latency histogram.
+ */
+struct histogram {
+        gint64 buckets[HISTOGRAM_BUCKETS]; /**< cumulative counts per bucket bound */
+        gint64 count;                      /**< total number of observations */
+        double sum;                        /**< sum of all observed values */
+};
+
+/**
+ * @brief Cumulative transfer phase times, to track where time is spent
+ *        (DNS, TCP/TLS connect, server think-time).
+ */
+struct transfer_phases {
+        double namelookup;            /**< DNS lookup time */
+        double connect;               /**< connect (incl. TLS handshake) time */
+        double starttransfer;         /**< time to first byte */
+};
+
+static gchar *metrics_path = NULL;
+static GMutex metrics_mutex;
+static struct histogram rest_duration;
+static struct histogram download_duration;
+static struct transfer_phases rest_phases;
+static struct transfer_phases download_phases;
+static gint64 polls_total = 0;
+static gint64 poll_failures_total = 0;
+
+void metrics_init(const gchar *path)
+{
+        metrics_path = g_strdup(path);
+}
+
+/**
+ * @brief Add an observation to a histogram.
+ *
+ * @param[in] histogram Histogram to update
+ * @param[in] value     Observed value in seconds
+ */
+static void histogram_observe(struct histogram *histogram, double value)
+{
+        gint i;
+
+        for (i = 0; i < HISTOGRAM_BUCKETS; i++)
+                if (value <= bucket_bounds[i])
+                        histogram->buckets[i]++;
+
+        histogram->count++;
+        histogram->sum += value;
+}
+
+void metrics_record_transfer(CURL *curl, gboolean download)
+{
+        struct histogram *histogram = download ? &download_duration : &rest_duration;
+        struct transfer_phases *phases = download ? &download_phases : &rest_phases;
+        double total = 0, namelookup = 0, connect_time = 0, starttransfer = 0;
+
+        g_return_if_fail(curl);
+
+        if (!metrics_path)
+                return;
+
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total);
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &namelookup);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &connect_time);
+        curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &starttransfer);
+
+        g_mutex_lock(&metrics_mutex);
+        histogram_observe(histogram, total);
+        phases->namelookup += namelookup;
+        phases->connect += connect_time;
+        phases->starttransfer += starttransfer;
+        g_mutex_unlock(&metrics_mutex);
+}
+
+void metrics_record_poll(gboolean success)
+{
+        if (!metrics_path)
+                return;
+
+        g_mutex_lock(&metrics_mutex);
+        polls_total++;
+        if (!success)
+                poll_failures_total++;
+        g_mutex_unlock(&metrics_mutex);
+}
+
+/**
+ * @brief Append a histogram in Prometheus text format.
+ *
+ * @param[in] out       GString to append to
+ * @param[in] name      Metric name
+ * @param[in] histogram Histogram to export
+ */
+static void histogram_export(GString *out, const gchar *name, struct histogram *histogram)
+{
+        gint i;
+
+        g_string_append_printf(out, "# TYPE %s histogram\n", name);
+        for (i = 0; i < HISTOGRAM_BUCKETS; i++)
+                g_string_append_printf(out, "%s_bucket{le=\"%g\"} %" G_GINT64_FORMAT "\n", name,
+                                       bucket_bounds[i], histogram->buckets[i]);
+        g_string_append_printf(out, "%s_bucket{le=\"+Inf\"} %" G_GINT64_FORMAT "\n", name,
+                               histogram->count);
+        g_string_append_printf(out, "%s_sum %g\n", name, histogram->sum);
+        g_string_append_printf(out, "%s_count %" G_GINT64_FORMAT "\n", name, histogram->count);
+}
+
+/**
+ * @brief Append cumulative transfer phase times in Prometheus text format.
+ *
+ * @param[in] out    GString to append to
+ * @param[in] prefix Metric name prefix
+ * @param[in] phases Phase times to export
+ */
+static void phases_export(GString *out, const gchar *prefix, struct transfer_phases *phases)
+{
+        g_string_append_printf(out, "%s_namelookup_seconds_total %g\n", prefix,
+                               phases->namelookup);
+        g_string_append_printf(out, "%s_connect_seconds_total %g\n", prefix, phases->connect);
+        g_string_append_printf(out, "%s_starttransfer_seconds_total %g\n", prefix,
+                               phases->starttransfer);
+}
+
+void metrics_write(void)
+{
+        g_autoptr(GString) out = NULL;
+        g_autoptr(GError) error = NULL;
+
+        if (!metrics_path)
+                return;
+
+        out = g_string_new(NULL);
+
+        g_mutex_lock(&metrics_mutex);
+        histogram_export(out, "rauc_hawkbit_rest_request_duration_seconds", &rest_duration);
+        histogram_export(out, "rauc_hawkbit_download_duration_seconds", &download_duration);
+        phases_export(out, "rauc_hawkbit_rest", &rest_phases);
+        phases_export(out, "rauc_hawkbit_download", &download_phases);
+        g_string_append_printf(out, "# TYPE rauc_hawkbit_polls_total counter\n"
+                               "rauc_hawkbit_polls_total %" G_GINT64_FORMAT "\n", polls_total);
+        g_string_append_printf(out, "# TYPE rauc_hawkbit_poll_failures_total counter\n"
+                               "rauc_hawkbit_poll_failures_total %" G_GINT64_FORMAT "\n",
+                               poll_failures_total);
+        g_mutex_unlock(&metrics_mutex);
+
+        if (!g_file_set_contents(metrics_path, out->str, out->len, &error))
+                g_warning("Failed to write metrics file %s: %s", metrics_path, error->message);
+}
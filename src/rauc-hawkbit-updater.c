@@ -63,6 +63,8 @@ static gboolean on_rauc_install_progress_cb(gpointer data)
                 // notify hawkbit server about progress
                 notify_hawkbit_install_progress(msg);
         }
+        // allow scheduling the next dispatch once the queue is drained
+        context->notify_pending = FALSE;
         g_mutex_unlock(&context->status_mutex);
 
         return G_SOURCE_REMOVE;
@@ -160,7 +162,7 @@ int main(int argc, char **argv)
 
         log_level = (opt_debug) ? G_LOG_LEVEL_MASK : config->log_level;
 
-        setup_logging(PROGRAM, log_level, opt_output_systemd);
+        setup_logging(PROGRAM, log_level, opt_output_systemd, config->log_async);
         hawkbit_init(config, on_new_software_ready_cb);
 
         return hawkbit_start_service_sync();
@@ -16,6 +16,15 @@
 #include "rauc-installer-gen.h"
 
 static GThread *thread_install = NULL;
+static GMutex worker_mutex;
+static GAsyncQueue *install_queue = NULL;
+
+// worker thread state: the persistent proxy and the job being processed.
+// current_context is handed over under its mutex, the signal callbacks hold
+// it for their whole run so the context cannot be freed underneath them
+static RInstaller *r_installer_proxy = NULL;
+static struct install_context *current_context = NULL;
+static GMutex current_context_mutex;
 
 /**
  * @brief RAUC DBUS property changed callback
@@ -25,12 +34,21 @@ static GThread *thread_install = NULL;
 static void on_installer_status(GDBusProxy *proxy, GVariant *changed,
                                 const gchar* const *invalidated, gpointer data)
 {
-        struct install_context *context = data;
+        struct install_context *context = NULL;
         gint32 percentage;
         g_autofree gchar *message = NULL;
 
         g_return_if_fail(changed);
-        g_return_if_fail(context);
+
+        g_mutex_lock(&current_context_mutex);
+
+        context = current_context;
+
+        // no installation in progress, stale signal
+        if (!context) {
+                g_mutex_unlock(&current_context_mutex);
+                return;
+        }
 
         if (invalidated && invalidated[0]) {
                 g_warning("RAUC DBUS service disappeared");
@@ -38,11 +56,12 @@ static void on_installer_status(GDBusProxy *proxy, GVariant *changed,
                 context->status_result = 2;
                 g_mutex_unlock(&context->status_mutex);
                 g_main_loop_quit(context->mainloop);
+                g_mutex_unlock(&current_context_mutex);
                 return;
         }
 
         if (context->notify_event) {
-                gboolean status_received = FALSE;
+                gboolean schedule_notify = FALSE;
 
                 g_mutex_lock(&context->status_mutex);
                 if (g_variant_lookup(changed, "Operation", "s", &message))
@@ -56,13 +75,20 @@ static void on_installer_status(GDBusProxy *proxy, GVariant *changed,
                         g_queue_push_tail(&context->status_messages,
                                           g_strdup_printf("LastError: %s", message));
 
-                status_received = !g_queue_is_empty(&context->status_messages);
+                // schedule at most one pending dispatch, the consumer drains
+                // the whole queue in one callback
+                schedule_notify = !g_queue_is_empty(&context->status_messages) &&
+                                  !context->notify_pending;
+                if (schedule_notify)
+                        context->notify_pending = TRUE;
                 g_mutex_unlock(&context->status_mutex);
 
-                if (status_received)
+                if (schedule_notify)
                         g_main_context_invoke(context->loop_context, context->notify_event,
                                               context);
         }
+
+        g_mutex_unlock(&current_context_mutex);
 }
 
 /**
@@ -72,9 +98,17 @@ static void on_installer_status(GDBusProxy *proxy, GVariant *changed,
  */
 static void on_installer_completed(GDBusProxy *proxy, gint result, gpointer data)
 {
-        struct install_context *context = data;
+        struct install_context *context = NULL;
 
-        g_return_if_fail(context);
+        g_mutex_lock(&current_context_mutex);
+
+        context = current_context;
+
+        // no installation in progress, stale signal
+        if (!context) {
+                g_mutex_unlock(&current_context_mutex);
+                return;
+        }
 
         g_mutex_lock(&context->status_mutex);
         context->status_result = result;
@@ -82,6 +116,8 @@ static void on_installer_completed(GDBusProxy *proxy, gint result, gpointer data
 
         if (result >= 0)
                 g_main_loop_quit(context->mainloop);
+
+        g_mutex_unlock(&current_context_mutex);
 }
 
 /**
@@ -95,6 +131,7 @@ static struct install_context *install_context_new(void)
         struct install_context *context = g_new0(struct install_context, 1);
 
         g_mutex_init(&context->status_mutex);
+        g_cond_init(&context->done_cond);
         g_queue_init(&context->status_messages);
         context->status_result = -2;
 
@@ -115,6 +152,7 @@ static void install_context_free(struct install_context *context)
         g_free(context->bundle);
         g_free(context->auth_header);
         g_mutex_clear(&context->status_mutex);
+        g_cond_clear(&context->done_cond);
 
         // make sure all pending events are processed
         while (g_main_context_iteration(context->loop_context, FALSE));
@@ -127,32 +165,28 @@ static void install_context_free(struct install_context *context)
 }
 
 /**
- * @brief RAUC client mainloop
- *
- * Install mainloop running until installation completes.
- * @param[in] data pointer to a install_context struct.
- * @return NULL is always returned.
+ * @brief Make sure the persistent RAUC DBUS proxy exists and is backed by a
+ *        live name owner, (re-)creating it if necessary. Proxy creation cost
+ *        is thus paid once, not per installation.
+ *        Must be called on the installer worker thread.
  */
-static gpointer install_loop_thread(gpointer data)
+static void ensure_installer_proxy(void)
 {
         GBusType bus_type = (!g_strcmp0(g_getenv("DBUS_STARTER_BUS_TYPE"), "session"))
                             ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM;
-        RInstaller *r_installer_proxy = NULL;
         g_autoptr(GError) error = NULL;
-        g_auto(GVariantDict) args = G_VARIANT_DICT_INIT(NULL);
-        struct install_context *context = NULL;
 
-        g_return_val_if_fail(data, NULL);
+        if (r_installer_proxy) {
+                g_autofree gchar *owner =
+                        g_dbus_proxy_get_name_owner(G_DBUS_PROXY(r_installer_proxy));
 
-        context = data;
-        g_main_context_push_thread_default(context->loop_context);
+                if (owner)
+                        return;
 
-        if (context->auth_header) {
-                gchar *headers[2] = {NULL, NULL};
-                headers[0] = context->auth_header;
-                g_variant_dict_insert(&args, "http-headers", "^as", headers);
-
-                g_variant_dict_insert(&args, "tls-no-verify", "b", !context->ssl_verify);
+                // name owner changed or disappeared, re-establish the proxy
+                g_debug("RAUC DBUS name owner gone, recreating proxy");
+                g_signal_handlers_disconnect_by_data(r_installer_proxy, NULL);
+                g_clear_object(&r_installer_proxy);
         }
 
         g_debug("Creating RAUC DBUS proxy");
@@ -161,42 +195,103 @@ static gpointer install_loop_thread(gpointer data)
                 "de.pengutronix.rauc", "/", NULL, &error);
         if (!r_installer_proxy) {
                 g_warning("Failed to create RAUC DBUS proxy: %s", error->message);
-                goto notify_complete;
+                return;
         }
+
         if (g_signal_connect(r_installer_proxy, "g-properties-changed",
-                             G_CALLBACK(on_installer_status), context) <= 0) {
+                             G_CALLBACK(on_installer_status), NULL) <= 0)
                 g_warning("Failed to connect properties-changed signal");
-                goto out_loop;
-        }
         if (g_signal_connect(r_installer_proxy, "completed",
-                             G_CALLBACK(on_installer_completed), context) <= 0) {
+                             G_CALLBACK(on_installer_completed), NULL) <= 0)
                 g_warning("Failed to connect completed signal");
-                goto out_loop;
+}
+
+/**
+ * @brief Process one queued installation on the worker thread: ensure the
+ *        proxy, trigger the installation and run the job's main loop until
+ *        completion.
+ *
+ * @param[in] context        install_context of the job
+ * @param[in] worker_context the worker's GMainContext
+ */
+static void process_install_job(struct install_context *context, GMainContext *worker_context)
+{
+        g_auto(GVariantDict) args = G_VARIANT_DICT_INIT(NULL);
+        g_autoptr(GError) error = NULL;
+        gboolean keep;
+
+        context->loop_context = g_main_context_ref(worker_context);
+        context->mainloop = g_main_loop_new(worker_context, FALSE);
+
+        if (context->auth_header) {
+                gchar *headers[2] = {NULL, NULL};
+                headers[0] = context->auth_header;
+                g_variant_dict_insert(&args, "http-headers", "^as", headers);
+
+                g_variant_dict_insert(&args, "tls-no-verify", "b", !context->ssl_verify);
         }
 
+        ensure_installer_proxy();
+        if (!r_installer_proxy)
+                goto notify_complete;
+
         g_debug("Trying to contact RAUC DBUS service");
         if (!r_installer_call_install_bundle_sync(r_installer_proxy, context->bundle,
                                                   g_variant_dict_end(&args), NULL, &error)) {
                 g_warning("%s", error->message);
-                goto out_loop;
+                goto notify_complete;
         }
 
         g_main_loop_run(context->mainloop);
 
-out_loop:
-        g_signal_handlers_disconnect_by_data(r_installer_proxy, context);
-
 notify_complete:
+        // detach from the signal callbacks before the context may be freed;
+        // an in-flight callback finishes first, since it holds the same mutex
+        g_mutex_lock(&current_context_mutex);
+        current_context = NULL;
+        g_mutex_unlock(&current_context_mutex);
+
+        keep = context->keep_install_context;
+
         // Notify the result of the RAUC installation
         if (context->notify_complete)
                 context->notify_complete(context);
 
-        g_clear_pointer(&r_installer_proxy, g_object_unref);
-        g_main_context_pop_thread_default(context->loop_context);
+        // wake a rauc_install() caller waiting for the result; on wait, the
+        // caller frees the context as soon as done is signaled, so it must
+        // not be touched afterwards
+        g_mutex_lock(&context->status_mutex);
+        context->done = TRUE;
+        g_cond_signal(&context->done_cond);
+        g_mutex_unlock(&context->status_mutex);
 
-        // on wait, calling function will take care of freeing after reading context->status_result
-        if (!context->keep_install_context)
+        if (!keep)
                 install_context_free(context);
+}
+
+/**
+ * @brief Long-lived installer worker: owns the persistent RAUC proxy and
+ *        processes queued installations one after another.
+ *
+ * @param[in] data unused
+ * @return NULL, the worker never exits
+ */
+static gpointer installer_worker_thread(gpointer data)
+{
+        GMainContext *worker_context = g_main_context_new();
+
+        g_main_context_push_thread_default(worker_context);
+
+        while (1) {
+                struct install_context *context = g_async_queue_pop(install_queue);
+
+                g_mutex_lock(&current_context_mutex);
+                current_context = context;
+                g_mutex_unlock(&current_context_mutex);
+
+                process_install_job(context, worker_context);
+        }
+
         return NULL;
 }
 
@@ -204,39 +299,43 @@ gboolean rauc_install(const gchar *bundle, const gchar *auth_header, gboolean ss
                       GSourceFunc on_install_notify, GSourceFunc on_install_complete,
                       gboolean wait)
 {
-        GMainContext *loop_context = NULL;
         struct install_context *context = NULL;
 
         g_return_val_if_fail(bundle, FALSE);
 
-        loop_context = g_main_context_new();
         context = install_context_new();
         context->bundle = g_strdup(bundle);
         context->auth_header = g_strdup(auth_header);
         context->ssl_verify = ssl_verify;
         context->notify_event = on_install_notify;
         context->notify_complete = on_install_complete;
-        context->mainloop = g_main_loop_new(loop_context, FALSE);
-        context->loop_context = loop_context;
         context->status_result = 2;
         context->keep_install_context = wait;
 
-        // unref/free previous install thread by joining it
-        if (thread_install)
-                g_thread_join(thread_install);
+        // start the worker once, it serves all subsequent installations
+        g_mutex_lock(&worker_mutex);
+        if (!install_queue) {
+                install_queue = g_async_queue_new();
+                thread_install = g_thread_new("installer", installer_worker_thread, NULL);
+        }
+        g_mutex_unlock(&worker_mutex);
+
+        g_async_queue_push(install_queue, context);
 
-        // start install thread
-        thread_install = g_thread_new("installer", install_loop_thread, (gpointer) context);
         if (wait) {
                 gboolean result;
 
-                g_thread_join(thread_install);
+                g_mutex_lock(&context->status_mutex);
+                while (!context->done)
+                        g_cond_wait(&context->done_cond, &context->status_mutex);
+                g_mutex_unlock(&context->status_mutex);
+
                 result = context->status_result == 0;
 
                 install_context_free(context);
                 return result;
         }
 
-        // return immediately if we did not wait for the install thread
+        // return immediately if we did not wait for the installation
         return TRUE;
 }
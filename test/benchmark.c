@@ -0,0 +1,398 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * SPDX-FileCopyrightText: 2022 Prevas A/S (www.prevas.com)
+ *
+ * @file
+ * @brief Benchmarks for the client's hot paths, run against an in-process
+ *        mock hawkBit DDI server. Results are printed as JSON lines so they
+ *        can be tracked per release.
+ *
+ * Build with -Dbenchmarks=enabled, run via "meson test --benchmark" or by
+ * invoking rauc-hawkbit-benchmark directly.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <curl/curl.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <json-glib/json-glib.h>
+
+#include "hash.h"
+#include "hawkbit-client.h"
+#include "json-helper.h"
+
+#define ARTIFACT_SIZE       (32 * 1024 * 1024)
+#define CHECKSUM_DATA_SIZE  (32 * 1024 * 1024)
+#define REST_REQUESTS       200
+#define JSONPATH_ITERATIONS 10000
+#define BUFFER_ITERATIONS   2000
+
+/**
+ * @brief Realistic deploymentBase response, used for the JSONPath and REST
+ *        round-trip benchmarks.
+ */
+static const gchar deployment_base_json[] =
+        "{"
+        "  \"id\": \"1729\","
+        "  \"deployment\": {"
+        "    \"download\": \"forced\","
+        "    \"update\": \"forced\","
+        "    \"maintenanceWindow\": \"available\","
+        "    \"chunks\": [{"
+        "      \"part\": \"os\","
+        "      \"version\": \"1.2.3\","
+        "      \"name\": \"core-image\","
+        "      \"artifacts\": [{"
+        "        \"filename\": \"core-image.raucb\","
+        "        \"hashes\": {"
+        "          \"sha1\": \"da39a3ee5e6b4b0d3255bfef95601890afd80709\","
+        "          \"md5\": \"d41d8cd98f00b204e9800998ecf8427e\","
+        "          \"sha256\": \"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\""
+        "        },"
+        "        \"size\": 33554432,"
+        "        \"_links\": {"
+        "          \"download\": {\"href\": \"https://localhost/artifact\"},"
+        "          \"download-http\": {\"href\": \"http://localhost/artifact\"},"
+        "          \"md5sum\": {\"href\": \"http://localhost/artifact.MD5SUM\"}"
+        "        }"
+        "      }]"
+        "    }]"
+        "  },"
+        "  \"_links\": {"
+        "    \"status\": {\"href\": \"http://localhost/feedback\"}"
+        "  }"
+        "}";
+
+/**
+ * @brief Mock hawkBit DDI server serving canned JSON and a generated
+ *        artifact, listening on localhost, running in its own thread.
+ */
+struct mock_server {
+        GThread *thread;              /**< server thread */
+        GMainLoop *loop;              /**< server main loop, valid once ready */
+        guint16 port;                 /**< bound localhost port */
+        GMutex ready_mutex;           /**< guards ready */
+        GCond ready_cond;             /**< signaled once listening */
+        gboolean ready;               /**< whether the server accepts requests */
+};
+
+static void print_result(const gchar *benchmark, double value, const gchar *unit)
+{
+        g_print("{\"benchmark\": \"%s\", \"value\": %.2f, \"unit\": \"%s\"}\n",
+                benchmark, value, unit);
+}
+
+static gboolean server_incoming_cb(GSocketService *service, GSocketConnection *connection,
+                                   GObject *source_object, gpointer user_data)
+{
+        GInputStream *in = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+        GOutputStream *out = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+
+        // serve requests on this connection until the client closes it, so
+        // the client's connection reuse is actually exercised
+        while (1) {
+                gchar request[4096] = {0};
+                gsize total = 0;
+
+                // read request until the header terminator
+                while (total < sizeof(request) - 1 && !strstr(request, "\r\n\r\n")) {
+                        gssize r = g_input_stream_read(in, request + total,
+                                                       sizeof(request) - 1 - total, NULL, NULL);
+                        if (r <= 0)
+                                return TRUE;
+
+                        total += r;
+                }
+
+                if (g_str_has_prefix(request, "GET /artifact")) {
+                        g_autofree gchar *header = g_strdup_printf(
+                                "HTTP/1.1 200 OK\r\n"
+                                "Content-Type: application/octet-stream\r\n"
+                                "Content-Length: %d\r\n\r\n", ARTIFACT_SIZE);
+                        static gchar chunk[64 * 1024];
+                        gsize remaining = ARTIFACT_SIZE;
+
+                        if (!g_output_stream_write_all(out, header, strlen(header), NULL, NULL,
+                                                       NULL))
+                                return TRUE;
+
+                        while (remaining) {
+                                gsize len = MIN(remaining, sizeof(chunk));
+
+                                if (!g_output_stream_write_all(out, chunk, len, NULL, NULL,
+                                                               NULL))
+                                        return TRUE;
+
+                                remaining -= len;
+                        }
+                } else {
+                        g_autofree gchar *response = g_strdup_printf(
+                                "HTTP/1.1 200 OK\r\n"
+                                "Content-Type: application/json;charset=UTF-8\r\n"
+                                "Content-Length: %zu\r\n\r\n%s",
+                                strlen(deployment_base_json), deployment_base_json);
+
+                        if (!g_output_stream_write_all(out, response, strlen(response), NULL,
+                                                       NULL, NULL))
+                                return TRUE;
+                }
+        }
+
+        return TRUE;
+}
+
+static gpointer server_thread_func(gpointer data)
+{
+        struct mock_server *server = data;
+        g_autoptr(GMainContext) context = g_main_context_new();
+        g_autoptr(GSocketService) service = NULL;
+        g_autoptr(GError) error = NULL;
+
+        g_main_context_push_thread_default(context);
+
+        service = g_socket_service_new();
+        server->port = g_socket_listener_add_any_inet_port(G_SOCKET_LISTENER(service), NULL,
+                                                           &error);
+        if (!server->port) {
+                g_printerr("Failed to start mock server: %s\n", error->message);
+                g_main_context_pop_thread_default(context);
+                return NULL;
+        }
+
+        g_signal_connect(service, "incoming", G_CALLBACK(server_incoming_cb), server);
+        g_socket_service_start(service);
+
+        server->loop = g_main_loop_new(context, FALSE);
+
+        g_mutex_lock(&server->ready_mutex);
+        server->ready = TRUE;
+        g_cond_signal(&server->ready_cond);
+        g_mutex_unlock(&server->ready_mutex);
+
+        g_main_loop_run(server->loop);
+
+        g_socket_service_stop(service);
+        g_main_context_pop_thread_default(context);
+        g_clear_pointer(&server->loop, g_main_loop_unref);
+
+        return NULL;
+}
+
+/**
+ * @brief Checksum throughput at various read buffer sizes, exercising the
+ *        production hash engine (GChecksum or OpenSSL EVP, as built) used by
+ *        the download hash path.
+ */
+static void bench_checksum(void)
+{
+        static const gsize buffer_sizes[] = {4 * 1024, 64 * 1024, 512 * 1024, 0};
+        g_autofree guchar *data = g_malloc(CHECKSUM_DATA_SIZE);
+        const gsize *buffer_size;
+        gsize i;
+
+        for (i = 0; i < CHECKSUM_DATA_SIZE; i++)
+                data[i] = (guchar) (i * 31);
+
+        for (buffer_size = buffer_sizes; *buffer_size; buffer_size++) {
+                g_autoptr(Hash) checksum = hash_new(HASH_TYPE_SHA1);
+                g_autofree gchar *name = NULL;
+                gint64 start = g_get_monotonic_time(), elapsed;
+                gsize offset;
+
+                for (offset = 0; offset < CHECKSUM_DATA_SIZE; offset += *buffer_size)
+                        hash_update(checksum, data + offset,
+                                    MIN(*buffer_size, CHECKSUM_DATA_SIZE - offset));
+
+                hash_get_string(checksum);
+                elapsed = g_get_monotonic_time() - start;
+
+                name = g_strdup_printf("checksum_sha1_%zuk", *buffer_size / 1024);
+                print_result(name,
+                             (double) CHECKSUM_DATA_SIZE / (1024 * 1024) * G_USEC_PER_SEC /
+                             elapsed, "MB/s");
+        }
+}
+
+/**
+ * @brief Response buffer growth cost: per-chunk realloc (historic reference
+ *        implementation) vs. the production curl_write_cb() path.
+ */
+static void bench_buffer_growth(void)
+{
+        static const gsize chunk_size = 16 * 1024, response_size = 512 * 1024;
+        g_autofree gchar *chunk = g_malloc(chunk_size);
+        gint64 start, elapsed;
+        gint i;
+
+        memset(chunk, 'x', chunk_size);
+
+        start = g_get_monotonic_time();
+        for (i = 0; i < BUFFER_ITERATIONS; i++) {
+                g_autofree gchar *payload = g_malloc0(512);
+                gsize size = 0;
+
+                while (size < response_size) {
+                        payload = g_realloc(payload, size + chunk_size + 1);
+                        memcpy(payload + size, chunk, chunk_size);
+                        size += chunk_size;
+                        payload[size] = '\0';
+                }
+        }
+        elapsed = g_get_monotonic_time() - start;
+        print_result("buffer_growth_historic", (double) elapsed * 1000 / BUFFER_ITERATIONS,
+                     "ns/response");
+
+        start = g_get_monotonic_time();
+        for (i = 0; i < BUFFER_ITERATIONS; i++) {
+                g_autoptr(RestPayload) payload = g_new0(RestPayload, 1);
+
+                payload->capacity = DEFAULT_CURL_REQUEST_BUFFER_SIZE;
+                payload->payload = g_malloc0(payload->capacity);
+
+                while (payload->size < response_size)
+                        g_assert(curl_write_cb(chunk, 1, chunk_size, payload) == chunk_size);
+        }
+        elapsed = g_get_monotonic_time() - start;
+        print_result("buffer_growth_curl_write_cb", (double) elapsed * 1000 / BUFFER_ITERATIONS,
+                     "ns/response");
+}
+
+/**
+ * @brief json-helper query cost on a realistic deploymentBase payload,
+ *        exercising the production helpers including the compiled path cache.
+ */
+static void bench_jsonpath(void)
+{
+        g_autoptr(JsonParser) parser = json_parser_new_immutable();
+        g_autoptr(GError) error = NULL;
+        JsonNode *root = NULL;
+        gint64 start, elapsed;
+        gint i;
+
+        if (!json_parser_load_from_data(parser, deployment_base_json, -1, &error)) {
+                g_printerr("Failed to parse benchmark JSON: %s\n", error->message);
+                return;
+        }
+
+        root = json_parser_get_root(parser);
+
+        start = g_get_monotonic_time();
+        for (i = 0; i < JSONPATH_ITERATIONS; i++) {
+                g_autofree gchar *id = json_get_string(root, "$.id", NULL);
+                g_autofree gchar *version = json_get_string(root,
+                                                            "$.deployment.chunks[0].version",
+                                                            NULL);
+                g_autoptr(JsonArray) chunks = json_get_array(root, "$.deployment.chunks", NULL);
+                gint64 size = json_get_int(root,
+                                           "$.deployment.chunks[0].artifacts[0].size", NULL);
+
+                g_assert(id && version && chunks && size);
+        }
+        elapsed = g_get_monotonic_time() - start;
+
+        print_result("jsonpath_queries", (double) elapsed / JSONPATH_ITERATIONS, "us/iteration");
+}
+
+/**
+ * @brief REST request/parse round-trip latency against the mock DDI server,
+ *        driven through the production request engine (handle/multi pools,
+ *        header callback, compression, share object, connection reuse).
+ */
+static void bench_rest_roundtrip(struct mock_server *server)
+{
+        g_autofree gchar *url = g_strdup_printf("http://127.0.0.1:%u/deploymentBase",
+                                                server->port);
+        gint64 start, elapsed;
+        gint i;
+
+        start = g_get_monotonic_time();
+        for (i = 0; i < REST_REQUESTS; i++) {
+                g_autoptr(JsonParser) parser = NULL;
+                g_autoptr(GError) error = NULL;
+
+                if (!rest_request(GET, url, NULL, &parser, NULL, NULL, &error)) {
+                        g_printerr("REST benchmark request failed: %s\n", error->message);
+                        return;
+                }
+        }
+        elapsed = g_get_monotonic_time() - start;
+
+        print_result("rest_roundtrip", (double) elapsed / REST_REQUESTS, "us/request");
+}
+
+/**
+ * @brief End-to-end artifact download throughput from the mock server,
+ *        through the production download path including preallocation,
+ *        streaming checksum and the raw descriptor write callback.
+ */
+static void bench_download(struct mock_server *server)
+{
+        g_autofree gchar *url = g_strdup_printf("http://127.0.0.1:%u/artifact", server->port);
+        g_autofree gchar *file = g_strdup("/tmp/rauc-hawkbit-benchmark-XXXXXX");
+        g_autofree gchar *checksum = NULL;
+        g_autoptr(GError) error = NULL;
+        curl_off_t speed = 0;
+        gint64 start, elapsed;
+        gint fd;
+
+        fd = g_mkstemp(file);
+        if (fd < 0) {
+                g_printerr("Failed to create download benchmark file\n");
+                return;
+        }
+        close(fd);
+
+        start = g_get_monotonic_time();
+        if (!get_binary(url, file, 0, ARTIFACT_SIZE, HASH_TYPE_SHA1, &checksum, &speed,
+                        &error)) {
+                g_printerr("Download benchmark request failed: %s\n", error->message);
+                g_remove(file);
+                return;
+        }
+        elapsed = g_get_monotonic_time() - start;
+
+        print_result("download_throughput",
+                     (double) ARTIFACT_SIZE / (1024 * 1024) * G_USEC_PER_SEC / elapsed, "MB/s");
+        g_remove(file);
+}
+
+/**
+ * @brief Minimal configuration for the production request/download engine.
+ */
+static Config benchmark_config = {
+        .auth_token = (gchar *) "benchmark",
+        .connect_timeout = 20,
+        .timeout = 60,
+        .download_buffer_size = 64 * 1024,
+        .rate_limit_window_start = -1,
+        .compress_responses = TRUE,
+};
+
+int main(int argc, char **argv)
+{
+        struct mock_server server = {0};
+
+        g_mutex_init(&server.ready_mutex);
+        g_cond_init(&server.ready_cond);
+
+        hawkbit_init(&benchmark_config, NULL);
+
+        server.thread = g_thread_new("mock-server", server_thread_func, &server);
+
+        g_mutex_lock(&server.ready_mutex);
+        while (!server.ready)
+                g_cond_wait(&server.ready_cond, &server.ready_mutex);
+        g_mutex_unlock(&server.ready_mutex);
+
+        bench_checksum();
+        bench_buffer_growth();
+        bench_jsonpath();
+        bench_rest_roundtrip(&server);
+        bench_download(&server);
+
+        // the server thread blocks on its kept-alive connections and exits
+        // with the process
+        return 0;
+}
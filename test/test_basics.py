@@ -5,9 +5,10 @@
 import re
 from configparser import ConfigParser
 
+from pexpect import EOF
 import pytest
 
-from helper import run
+from helper import run, run_pexpect
 
 def test_version():
     """Test version argument."""
@@ -140,20 +141,43 @@ def test_identify(hawkbit, config):
 
     assert dict(ref_config.items('device')) == hawkbit.get_attributes()
 
-@pytest.mark.parametrize("multi_object", ('chunks', 'artifacts'))
-def test_unsupported_multi_objects(hawkbit, config, assign_bundle, multi_object):
+def test_poll_unchanged_response_skipped(hawkbit, adjust_config):
     """
-    Test that deployments with multiple software modules (called chunks in the DDI API) or multiple
-    artifacts are rejected.
+    Test that polls returning the same content as the last fully processed response are
+    short-circuited without reprocessing.
     """
-    expected_error = rf'Deployment \d*? unsupported: cannot handle multiple {multi_object}.'
+    hawkbit.set_config('pollingTime', '00:00:10')
 
-    if multi_object == 'chunks':
-        assign_param = {'swmodules_num': 2}
-    elif multi_object == 'artifacts':
-        assign_param = {'artifacts_num': 2}
+    try:
+        config = adjust_config({'client': {'log_level': 'debug'}})
+        proc = run_pexpect(f'rauc-hawkbit-updater -c "{config}"')
 
-    assign_bundle(**assign_param)
+        # first poll provides the device attributes
+        proc.expect('Checking for new software...')
+        proc.expect('No new software.')
+
+        # second poll: the configData link is gone, so the response changed
+        # and is processed once more
+        proc.expect('Checking for new software...', timeout=15)
+        proc.expect('No new software.')
+
+        # third poll: the response matches the last fully processed one,
+        # processing is skipped
+        proc.expect('Response content unchanged', timeout=15)
+
+        proc.terminate(force=True)
+        proc.expect(EOF)
+    finally:
+        hawkbit.set_config('pollingTime', '00:00:30')
+
+def test_unsupported_multi_artifacts(hawkbit, config, assign_bundle):
+    """
+    Test that deployments with multiple artifacts within one software module (called chunk in the
+    DDI API) are rejected.
+    """
+    expected_error = r'Deployment \d*? unsupported: cannot handle multiple artifacts per chunk.'
+
+    assign_bundle(artifacts_num=2)
 
     out, err, exitcode = run(f'rauc-hawkbit-updater -c "{config}" -r')
 
@@ -163,3 +187,24 @@ def test_unsupported_multi_objects(hawkbit, config, assign_bundle, multi_object)
     status = hawkbit.get_action_status()
     assert status[0]['type'] == 'error'
     assert re.fullmatch(expected_error, status[0]['messages'][0])
+
+def test_multi_chunk_deployment(hawkbit, config, assign_bundle, rauc_dbus_install_success):
+    """
+    Test that deployments with multiple software modules (called chunks in the DDI API) are
+    downloaded and installed one after another.
+    """
+    assign_bundle(swmodules_num=2)
+
+    out, err, exitcode = run(f'rauc-hawkbit-updater -c "{config}" -r')
+
+    assert exitcode == 0
+    assert 'Start downloading (1/2)' in out
+    assert 'Start downloading (2/2)' in out
+    assert 'Download complete (1/2).' in out
+    assert 'Download complete (2/2).' in out
+    assert 'Artifact installed, deployment continues.' in out
+    assert 'Software bundle installed successfully.' in out
+    assert err == ''
+
+    status = hawkbit.get_action_status()
+    assert status[0]['type'] == 'finished'
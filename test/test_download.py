@@ -124,6 +124,57 @@ def test_download_slow_with_resume(hawkbit, bundle_assigned, adjust_config, rate
     assert 'Download complete.' in out
     assert 'File checksum OK.' in out
 
+def test_download_parallel_connections(hawkbit, bundle_assigned, adjust_config,
+                                       rauc_dbus_install_success):
+    """
+    Assign bundle to target and test download over multiple concurrent range request
+    connections.
+    """
+    config = adjust_config(
+        {'client': {'download_connections': '2', 'log_level': 'debug'}}
+    )
+    out, err, exitcode = run(f'rauc-hawkbit-updater -c "{config}" -r')
+
+    assert re.search(r'Downloading \d+ bytes over 2 connections', out)
+    assert 'Download complete.' in out
+    assert 'File checksum OK.' in out
+    assert 'Software bundle installed successfully.' in out
+    assert err == ''
+    assert exitcode == 0
+
+def test_download_from_bundle_cache(hawkbit, adjust_config, assign_bundle,
+                                    rauc_dbus_install_success, tmp_path):
+    """
+    Assign, install and then re-assign the same bundle with the bundle cache enabled. The
+    re-assigned deployment must be provided from the cache without downloading again.
+    """
+    config = adjust_config(
+        {'client': {'bundle_cache_dir': str(tmp_path / 'bundle-cache')}}
+    )
+    assign_bundle()
+
+    out, err, exitcode = run(f'rauc-hawkbit-updater -c "{config}" -r')
+
+    assert 'Start downloading' in out
+    assert 'Software bundle installed successfully.' in out
+    assert err == ''
+    assert exitcode == 0
+
+    # re-assign the same software, its checksum matches the cached bundle
+    assign_bundle()
+
+    out, err, exitcode = run(f'rauc-hawkbit-updater -c "{config}" -r')
+
+    assert 'Using cached bundle' in out
+    assert 'Start downloading' not in out
+    assert 'Download complete. Provided from local cache.' in out
+    assert 'Software bundle installed successfully.' in out
+    assert err == ''
+    assert exitcode == 0
+
+    status = hawkbit.get_action_status()
+    assert status[0]['type'] == 'finished'
+
 def test_download_only(hawkbit, config, assign_bundle):
     """Test "downloadonly" deployment."""
     assign_bundle(params={'type': 'downloadonly'})